@@ -0,0 +1,396 @@
+#include "bench/cycles.hpp"
+#include "xoodyak.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined __linux__
+#include <sched.h>
+#endif
+
+// Cycles-per-byte & latency distribution benchmark harness for Xoodyak hash and
+// AEAD, which times each call on its own ( using TSC or, when asked for, core
+// cycle counter ), reporting p50/ p99/ p99.9 latency and cycles/ byte, over a
+// sweep of input lengths from 0 -bytes to 64 MiB, including lengths around
+// ( multiples of ) Cyclist rates, i.e. R_Hash, R_Kin and R_Kout. Results are
+// emitted as JSON, for regression tracking.
+//
+// Compile it with
+//
+// make bench/cycles.out
+//
+// Usage
+//
+// ./bench/cycles.out [--ops hash,encrypt,decrypt,absorb] [--max BYTES]
+//                    [--budget BYTES] [--samples N] [--ad BYTES] [--cpu N]
+//                    [--perf] [-o FILE]
+
+namespace {
+
+using namespace bench_cycles;
+
+constexpr size_t knt_len = 16ul;
+
+// Benchmark options, settable from command line
+struct options_t
+{
+  std::vector<std::string> ops{ "hash", "encrypt", "decrypt", "absorb" };
+  size_t max_len = 64ul << 20; // longest input, in bytes
+  size_t budget = 64ul << 20;  // # -of input bytes processed, per case
+  size_t samples = 100000ul;   // most # -of timed calls, per case
+  size_t min_samples = 5ul;    // fewest # -of timed calls, per case
+  size_t ad_len = 0ul;         // associated data length, for encrypt/ decrypt
+  long cpu = -1;               // CPU to pin benchmark thread to, if >= 0
+  bool perf = false;           // count core cycles, instead of TSC ticks
+  const char* out = nullptr;   // JSON output file, instead of stdout
+};
+
+void
+usage()
+{
+  std::fputs(
+    "Usage: cycles.out [OPTION]...\n"
+    "Report cycles/ byte & per-call latency of Xoodyak hash/ AEAD, as JSON.\n\n"
+    "  --ops LIST       comma separated of hash,encrypt,decrypt,absorb\n"
+    "  --max BYTES      longest input ( default: 67108864 )\n"
+    "  --budget BYTES   input bytes processed per case ( default: 67108864 )\n"
+    "  --samples N      most timed calls per case ( default: 100000 )\n"
+    "  --ad BYTES       associated data for encrypt/ decrypt ( default: 0 )\n"
+    "  --cpu N          pin to CPU N\n"
+    "  --perf           count core cycles, using perf_event_open(2)\n"
+    "  -o FILE          write JSON to FILE, instead of stdout\n",
+    stderr);
+}
+
+// Input lengths to sweep i.e. 0, 1, lengths around one & two blocks of each of
+// Cyclist rates, then powers of 2 ( and one byte shorter than them ), up to
+// `max_len`
+std::vector<size_t>
+sweep(const size_t max_len)
+{
+  std::vector<size_t> lens{ 0ul, 1ul };
+
+  for (const size_t r : { cyclist::R_Hash, cyclist::R_Kin, cyclist::R_Kout }) {
+    for (const size_t l : { r - 1, r, r + 1, 2 * r - 1, 2 * r, 2 * r + 1 }) {
+      lens.push_back(l);
+    }
+  }
+
+  for (size_t l = 64ul; l <= max_len; l <<= 1) {
+    lens.push_back(l - 1);
+    lens.push_back(l);
+  }
+
+  std::sort(lens.begin(), lens.end());
+  lens.erase(std::unique(lens.begin(), lens.end()), lens.end());
+  lens.erase(std::upper_bound(lens.begin(), lens.end(), max_len), lens.end());
+
+  return lens;
+}
+
+const char*
+isa_name(const xoodoo::isa_t isa)
+{
+  switch (isa) {
+    case xoodoo::isa_t::avx512:
+      return "avx512";
+    case xoodoo::isa_t::avx2:
+      return "avx2";
+    case xoodoo::isa_t::ssse3:
+      return "ssse3";
+    case xoodoo::isa_t::sse2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+// Times n calls of given routine, one at a time, returning per-call latency
+// samples, after subtracting counter overhead
+template<typename fn_t>
+std::vector<uint64_t>
+measure(const ticker_t& t, const uint64_t overhead, const size_t n, fn_t&& fn)
+{
+  std::vector<uint64_t> samples(n);
+
+  // warm up caches, branch predictors & bring core out of low frequency state
+  for (size_t i = 0; i < std::min<size_t>(n, 16); i++) {
+    fn();
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    const uint64_t t0 = t.start();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    fn();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    const uint64_t t1 = t.stop();
+
+    const uint64_t d = t1 - t0;
+    samples[i] = d > overhead ? d - overhead : 0ul;
+  }
+
+  return samples;
+}
+
+// Benchmarks single ( operation, input length ) case, returning latency
+// samples, while input & output buffers are allocated & filled beforehand
+std::vector<uint64_t>
+run_case(const options_t& opt,
+         const ticker_t& t,
+         const uint64_t overhead,
+         const std::string& op,
+         const size_t len)
+{
+  const size_t per_call = std::max<size_t>(len, 64);
+  const size_t n =
+    std::clamp(opt.budget / per_call, opt.min_samples, opt.samples);
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len);
+  std::vector<uint8_t> data(op == "absorb" ? len : opt.ad_len);
+  std::vector<uint8_t> msg(op == "absorb" ? 0ul : len), out(msg.size());
+  std::vector<uint8_t> digest(xoodyak::DIGEST_LEN);
+
+  xoodyak_utils::random_data(key.data(), key.size());
+  xoodyak_utils::random_data(nonce.data(), nonce.size());
+  xoodyak_utils::random_data(data.data(), data.size());
+  xoodyak_utils::random_data(msg.data(), msg.size());
+
+  if (op == "hash") {
+    return measure(t, overhead, n, [&]() {
+      xoodyak::hash(msg.data(), msg.size(), digest.data());
+    });
+  }
+
+  if (op == "decrypt") {
+    std::vector<uint8_t> enc(msg.size());
+    xoodyak::encrypt(key.data(),
+                     nonce.data(),
+                     data.data(),
+                     data.size(),
+                     msg.data(),
+                     enc.data(),
+                     msg.size(),
+                     tag.data());
+
+    return measure(t, overhead, n, [&]() {
+      const bool f = xoodyak::decrypt(key.data(),
+                                      nonce.data(),
+                                      tag.data(),
+                                      data.data(),
+                                      data.size(),
+                                      enc.data(),
+                                      out.data(),
+                                      enc.size());
+      if (!f) {
+        std::abort();
+      }
+    });
+  }
+
+  // both `encrypt` & `absorb` ( i.e. encrypt with only associated data )
+  return measure(t, overhead, n, [&]() {
+    xoodyak::encrypt(key.data(),
+                     nonce.data(),
+                     data.data(),
+                     data.size(),
+                     msg.data(),
+                     out.data(),
+                     msg.size(),
+                     tag.data());
+  });
+}
+
+bool
+parse_size(const char* const val, size_t* const v)
+{
+  char* end = nullptr;
+  *v = std::strtoul(val, &end, 10);
+  return (end != val) && (*end == '\0');
+}
+
+bool
+parse_ops(const char* const val, std::vector<std::string>* const ops)
+{
+  ops->clear();
+
+  std::string s(val);
+  size_t off = 0ul;
+  while (off <= s.size()) {
+    const size_t end = std::min(s.find(',', off), s.size());
+    const std::string op = s.substr(off, end - off);
+
+    if ((op != "hash") && (op != "encrypt") && (op != "decrypt") &&
+        (op != "absorb")) {
+      return false;
+    }
+
+    ops->push_back(op);
+    off = end + 1;
+  }
+
+  return true;
+}
+
+bool
+parse_args(const int argc, char** const argv, options_t* const opt)
+{
+  for (int i = 1; i < argc; i++) {
+    const std::string arg(argv[i]);
+
+    if (arg == "--perf") {
+      opt->perf = true;
+      continue;
+    }
+    if (i + 1 == argc) {
+      return false;
+    }
+
+    const char* const val = argv[++i];
+    size_t v = 0ul;
+
+    if (arg == "--ops") {
+      if (!parse_ops(val, &opt->ops)) {
+        return false;
+      }
+    } else if (arg == "-o") {
+      opt->out = val;
+    } else if (!parse_size(val, &v)) {
+      return false;
+    } else if (arg == "--max") {
+      opt->max_len = v;
+    } else if (arg == "--budget") {
+      opt->budget = v;
+    } else if ((arg == "--samples") && (v > 0)) {
+      opt->samples = v;
+      opt->min_samples = std::min(opt->min_samples, v);
+    } else if (arg == "--ad") {
+      opt->ad_len = v;
+    } else if (arg == "--cpu") {
+      opt->cpu = static_cast<long>(v);
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Pins calling thread to given CPU, so that it's not migrated between cores
+// ( TSC of different cores may not be in sync ) while being timed
+bool
+pin(const long cpu)
+{
+#if defined __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(static_cast<int>(cpu), &set);
+  return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+// Writes latency statistic, both in counter ticks & ( when counter ticks at
+// known rate ) in nanoseconds
+void
+emit_stat(FILE* const f,
+          const char* const name,
+          const double ticks,
+          const double ticks_per_ns)
+{
+  std::fprintf(f, ", \"%s\": %.1f", name, ticks);
+  if (ticks_per_ns > 0.0) {
+    std::fprintf(f, ", \"%s_ns\": %.1f", name, ticks / ticks_per_ns);
+  }
+}
+
+}
+
+int
+main(int argc, char** argv)
+{
+  options_t opt;
+  if (!parse_args(argc, argv, &opt)) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  if ((opt.cpu >= 0) && !pin(opt.cpu)) {
+    std::fprintf(stderr, "cycles.out: can't pin to CPU %ld\n", opt.cpu);
+    return EXIT_FAILURE;
+  }
+
+  FILE* const f = opt.out == nullptr ? stdout : std::fopen(opt.out, "w");
+  if (f == nullptr) {
+    std::fprintf(stderr, "cycles.out: %s: %s\n", opt.out, std::strerror(errno));
+    return EXIT_FAILURE;
+  }
+
+  const ticker_t t(opt.perf);
+  if (opt.perf && (t.src != counter_t::perf)) {
+    std::fprintf(stderr,
+                 "cycles.out: perf_event_open: %s, falling back to %s\n",
+                 std::strerror(errno),
+                 counter_name(t.src));
+  }
+
+  const double ticks_per_ns = t.ticks_per_ns();
+  const uint64_t overhead = t.overhead();
+  const std::vector<size_t> lens = sweep(opt.max_len);
+
+  std::fprintf(f,
+               "{\n  \"counter\": \"%s\",\n  \"ticks_per_ns\": %.4f,\n"
+               "  \"overhead\": %lu,\n  \"isa\": \"%s\",\n  \"cpu\": %ld,\n"
+               "  \"ad_len\": %zu,\n  \"results\": [",
+               counter_name(t.src),
+               ticks_per_ns,
+               static_cast<unsigned long>(overhead),
+               isa_name(xoodoo::active_isa()),
+               opt.cpu,
+               opt.ad_len);
+
+  bool first = true;
+  for (const std::string& op : opt.ops) {
+    for (const size_t len : lens) {
+      std::vector<uint64_t> samples = run_case(opt, t, overhead, op, len);
+      const stats_t s = summarize(samples);
+
+      std::fprintf(f,
+                   "%s\n    { \"op\": \"%s\", \"len\": %zu, \"samples\": %zu",
+                   first ? "" : ",",
+                   op.c_str(),
+                   len,
+                   samples.size());
+
+      emit_stat(f, "min", static_cast<double>(s.min), ticks_per_ns);
+      emit_stat(f, "p50", static_cast<double>(s.p50), ticks_per_ns);
+      emit_stat(f, "p99", static_cast<double>(s.p99), ticks_per_ns);
+      emit_stat(f, "p999", static_cast<double>(s.p999), ticks_per_ns);
+      emit_stat(f, "max", static_cast<double>(s.max), ticks_per_ns);
+      emit_stat(f, "mean", s.mean, ticks_per_ns);
+
+      // steady-state cost per byte, from median latency
+      if (len > 0) {
+        const double p50 = static_cast<double>(s.p50);
+        std::fprintf(f, ", \"per_byte\": %.3f", p50 / static_cast<double>(len));
+      }
+
+      std::fputs(" }", f);
+      std::fflush(f);
+      first = false;
+    }
+  }
+
+  std::fputs("\n  ]\n}\n", f);
+
+  if (f != stdout) {
+    std::fclose(f);
+  }
+
+  return EXIT_SUCCESS;
+}
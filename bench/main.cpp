@@ -4,6 +4,18 @@
 // Register for benchmarking Xoodoo[12] Permutation
 BENCHMARK(bench_xoodyak::xoodoo);
 
+// Register for benchmarking reduced round Xoodoo[6] Permutation
+BENCHMARK(bench_xoodyak::xoodoo<6>);
+
+// Register for benchmarking 8-way Xoodoo[12] Permutation
+BENCHMARK(bench_xoodyak::xoodoo_xN<8>);
+
+// Register for benchmarking 16-way Xoodoo[12] Permutation
+BENCHMARK(bench_xoodyak::xoodoo_xN<16>);
+
+// Register for benchmarking 16-way Xoodoo[6] Permutation
+BENCHMARK(bench_xoodyak::xoodoo_xN<16, 6>);
+
 // Register Xoodyak cryptographic hash function for benchmark with specified
 // size of input message bytes
 BENCHMARK(bench_xoodyak::hash)->Arg(64);
@@ -14,6 +26,29 @@ BENCHMARK(bench_xoodyak::hash)->Arg(1024);
 BENCHMARK(bench_xoodyak::hash)->Arg(2048);
 BENCHMARK(bench_xoodyak::hash)->Arg(4096);
 
+// Register Xoodyak cryptographic hash function, computing 8 digests at once,
+// for benchmark with specified size of each input message
+BENCHMARK(bench_xoodyak::hash_xN<8>)->Arg(64);
+BENCHMARK(bench_xoodyak::hash_xN<8>)->Arg(256);
+BENCHMARK(bench_xoodyak::hash_xN<8>)->Arg(1024);
+BENCHMARK(bench_xoodyak::hash_xN<8>)->Arg(4096);
+
+// Register Xoodyak cryptographic hash function, computing 16 digests at once,
+// for benchmark with specified size of each input message
+BENCHMARK(bench_xoodyak::hash_xN<16>)->Arg(64);
+BENCHMARK(bench_xoodyak::hash_xN<16>)->Arg(256);
+BENCHMARK(bench_xoodyak::hash_xN<16>)->Arg(1024);
+BENCHMARK(bench_xoodyak::hash_xN<16>)->Arg(4096);
+
+// Register Xoodyak based parallel tree hash function for benchmark with
+// specified size of input message bytes
+BENCHMARK(bench_xoodyak::tree_hash)->Arg(1 << 20);
+BENCHMARK(bench_xoodyak::tree_hash)->Arg(16 << 20);
+
+// Register chunked Xoodyak AEAD for benchmark, on large payloads
+BENCHMARK(bench_xoodyak::seal_chunked)->Arg(1 << 20)->UseRealTime();
+BENCHMARK(bench_xoodyak::seal_chunked)->Arg(16 << 20)->UseRealTime();
+
 // Register Xoodyak AEAD encrypt/ decrypt function for benchmark with fixed
 // length associated data but variable length plain text
 BENCHMARK(bench_xoodyak::encrypt)->Args({ 32, 64 });
@@ -37,5 +72,74 @@ BENCHMARK(bench_xoodyak::decrypt)->Args({ 32, 2048 });
 BENCHMARK(bench_xoodyak::encrypt)->Args({ 32, 4096 });
 BENCHMARK(bench_xoodyak::decrypt)->Args({ 32, 4096 });
 
+// Register Xoodyak AEAD encrypt function, reusing key schedule, side by side
+// with the one absorbing key for every message, for benchmark with short plain
+// text, where saving key absorption matters the most
+BENCHMARK(bench_xoodyak::encrypt_keyed)->Args({ 0, 0 });
+BENCHMARK(bench_xoodyak::encrypt)->Args({ 0, 0 });
+
+BENCHMARK(bench_xoodyak::encrypt_keyed)->Args({ 0, 16 });
+BENCHMARK(bench_xoodyak::encrypt)->Args({ 0, 16 });
+
+BENCHMARK(bench_xoodyak::encrypt_keyed)->Args({ 32, 32 });
+BENCHMARK(bench_xoodyak::encrypt)->Args({ 32, 32 });
+
+BENCHMARK(bench_xoodyak::encrypt_keyed)->Args({ 0, 64 });
+BENCHMARK(bench_xoodyak::encrypt)->Args({ 0, 64 });
+
+BENCHMARK(bench_xoodyak::encrypt_keyed)->Args({ 32, 64 });
+BENCHMARK(bench_xoodyak::encrypt)->Args({ 32, 64 });
+
+BENCHMARK(bench_xoodyak::encrypt_keyed)->Args({ 0, 1024 });
+BENCHMARK(bench_xoodyak::encrypt)->Args({ 0, 1024 });
+
+// Register in-place Xoodyak AEAD encrypt function for benchmark with fixed
+// length associated data but variable length plain text
+BENCHMARK(bench_xoodyak::encrypt_inplace)->Args({ 32, 64 });
+BENCHMARK(bench_xoodyak::encrypt_inplace)->Args({ 32, 1024 });
+
+// Register Xoodyak verified decryption for benchmark on forged input, writing
+// then wiping unverified plain text vs. verifying tag before writing anything
+BENCHMARK(bench_xoodyak::decrypt_forged<false>)->Args({ 32, 4096 });
+BENCHMARK(bench_xoodyak::decrypt_forged<true>)->Args({ 32, 4096 });
+BENCHMARK(bench_xoodyak::decrypt_forged<false>)->Args({ 32, 65536 });
+BENCHMARK(bench_xoodyak::decrypt_forged<true>)->Args({ 32, 65536 });
+
+// Register Xoodyak scatter-gather AEAD encrypt function for benchmark with
+// plain text split into MTU sized segments
+BENCHMARK(bench_xoodyak::encryptv)->Arg(4096);
+BENCHMARK(bench_xoodyak::encryptv)->Arg(16384);
+
+// Register Xoodyak session mode seal function for benchmark with fixed length
+// associated data but short plain text, to be compared against one-shot
+// encrypt function, which absorbs key & nonce for every message
+BENCHMARK(bench_xoodyak::session_seal)->Args({ 32, 32 });
+BENCHMARK(bench_xoodyak::session_seal)->Args({ 32, 64 });
+
+// Register Xoodyak message authentication code for benchmark with variable
+// length message
+BENCHMARK(bench_xoodyak::mac)->Arg(64);
+BENCHMARK(bench_xoodyak::mac)->Arg(1024);
+
+// Register multi-buffer Xoodyak message authentication code for benchmark with
+// specified number of messages ( of different lengths ) authenticated at once
+BENCHMARK(bench_xoodyak::mac_batch)->Arg(32);
+BENCHMARK(bench_xoodyak::mac_batch)->Arg(256);
+
+// Register multi-buffer Xoodyak AEAD encrypt function for benchmark with
+// specified number of messages ( of different lengths ) sealed at once
+BENCHMARK(bench_xoodyak::encrypt_batch)->Arg(32);
+BENCHMARK(bench_xoodyak::encrypt_batch)->Arg(256);
+
+// Register multi-buffer Xoodyak hash for benchmark, on bursts of 64 -bytes
+// messages
+BENCHMARK(bench_xoodyak::hash_batch)->Arg(32);
+BENCHMARK(bench_xoodyak::hash_batch)->Arg(1024);
+
+// Register Xoodyak batch hashing engine for benchmark, with skewed message
+// lengths, comparing it against hashing one message after another
+BENCHMARK(bench_xoodyak::hash_engine)->Args({ 4096, 0 })->UseRealTime();
+BENCHMARK(bench_xoodyak::hash_engine)->Args({ 4096, 1 })->UseRealTime();
+
 // main function to drive benchmark execution
 BENCHMARK_MAIN();
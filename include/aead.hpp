@@ -0,0 +1,321 @@
+#pragma once
+#include "key_schedule.hpp"
+#include "xoodyak.hpp"
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Online Xoodyak AEAD context, which can consume associated data and plain/
+// cipher text arriving in arbitrary sized chunks, by calling `absorb_ad(...)`
+// as many times as needed, followed by `encrypt_update(...)` or
+// `decrypt_update(...)` as many times as needed, before calling `finalize(...)`
+// ( or `verify(...)` ) once, for producing ( or checking ) 16 -bytes
+// authentication tag.
+//
+// Produces exactly same cipher text and tag as `encrypt(...)` does, when called
+// on all chunks, concatenated. No input is ever buffered, because partially
+// filled blocks are XORed into permutation state, byte by byte, as they arrive.
+//
+// Note, decrypted bytes are released before authentication tag can be checked,
+// so they must not be consumed before `verify(...)` returns truth value.
+//
+// See section 1.3.2 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+struct aead_t
+{
+private:
+  enum class stage_t : uint8_t
+  {
+    AD,    // absorbing associated data
+    Crypt, // encrypting/ decrypting text
+    Done   // authentication tag is already squeezed
+  };
+
+  enum class dir_t : uint8_t
+  {
+    None,
+    Encrypt,
+    Decrypt
+  };
+
+  alignas(16) uint32_t state[12]{};
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+
+  stage_t stage = stage_t::AD;
+  dir_t dir = dir_t::None;
+
+  // how many blocks are already started, in current stage
+  size_t blk_cnt = 0ul;
+  // whether current block is started, but not yet padded & its byte offset
+  bool open = false;
+  size_t pos = 0ul;
+
+  // Starts a new associated data/ text block, by permuting the state, so that
+  // next ( at max ) rate -bytes can be XORed into it
+  inline void start_block()
+  {
+    using cyclist::mode_t;
+
+    if ((stage == stage_t::Crypt) && (blk_cnt == 0ul)) {
+      cyclist::up<mode_t::Keyed, cyclist::Crypt_Color>(
+        state, nullptr, 0ul, &ph);
+    } else {
+      cyclist::up<mode_t::Keyed, cyclist::Zero_Color>(state, nullptr, 0ul, &ph);
+    }
+
+    open = true;
+    pos = 0ul;
+  }
+
+  // Closes currently started block, by appending padding byte ( and domain
+  // seperator color, if it's first associated data block ), same as `down(...)`
+  // does
+  inline void close_block()
+  {
+    cyclist::xor_byte(state, pos, 0x01);
+    if ((stage == stage_t::AD) && (blk_cnt == 0ul)) {
+      state[11] ^= static_cast<uint32_t>(cyclist::Absorb_Color_Keyed) << 24;
+    }
+
+    ph = cyclist::phase_t::Down;
+    open = false;
+    blk_cnt++;
+  }
+
+  // Finishes current stage, while ensuring that at least one ( possibly empty )
+  // block is processed in it, same as `absorb(...)`/ `crypt(...)` do
+  inline void end_stage()
+  {
+    if (open) {
+      close_block();
+    } else if (blk_cnt == 0ul) {
+      start_block();
+      close_block();
+    }
+
+    blk_cnt = 0ul;
+  }
+
+  // Encrypts/ decrypts ( based on template parameter's truthness ) N -bytes
+  // input chunk, continuing from where previous chunk left off
+  template<const bool decrypt>
+  inline void crypt_chunk(const uint8_t* const __restrict in,
+                          uint8_t* const __restrict out,
+                          const size_t io_len)
+  {
+    using cyclist::mode_t;
+    constexpr size_t rate = cyclist::R_Kout;
+
+    size_t off = 0ul;
+    while (off < io_len) {
+      // full blocks are processed lane-wise, using routines of Cyclist mode
+      if (!open && ((io_len - off) >= rate)) {
+        if (blk_cnt == 0ul) {
+          cyclist::up<mode_t::Keyed, cyclist::Crypt_Color>(
+            state, out + off, rate, &ph);
+        } else {
+          cyclist::up<mode_t::Keyed, cyclist::Zero_Color>(
+            state, out + off, rate, &ph);
+        }
+
+        for (size_t i = 0; i < rate; i++) {
+          out[off + i] ^= in[off + i];
+        }
+
+        const uint8_t* const blk = decrypt ? out + off : in + off;
+        cyclist::down<mode_t::Keyed, cyclist::Zero_Color>(state, blk, rate, &ph);
+
+        blk_cnt++;
+        off += rate;
+
+        continue;
+      }
+
+      if (!open) {
+        start_block();
+      }
+
+      const size_t read = std::min(rate - pos, io_len - off);
+      for (size_t i = 0; i < read; i++) {
+        const uint8_t b = in[off + i];
+        const uint8_t o = b ^ cyclist::get_byte(state, pos + i);
+
+        out[off + i] = o;
+        cyclist::xor_byte(state, pos + i, decrypt ? o : b);
+      }
+
+      pos += read;
+      off += read;
+
+      if (pos == rate) {
+        close_block();
+      }
+    }
+  }
+
+public:
+  // Absorbs 16 -bytes secret key & 16 -bytes public message nonce into
+  // permutation state, so that context is ready for consuming associated data
+  inline aead_t(const uint8_t* const __restrict key,  // 128 -bit secret key
+                const uint8_t* const __restrict nonce // 128 -bit message nonce
+  )
+  {
+    cyclist::absorb_key(state, key, nonce, &ph);
+  }
+
+  // Restores keyed permutation state from key schedule and absorbs 16 -bytes
+  // public message nonce into it, so that context is ready for consuming
+  // associated data
+  inline aead_t(const key_schedule_t& ks,                // expanded secret key
+                const uint8_t* const __restrict nonce // 128 -bit message nonce
+  )
+  {
+    ks.absorb_nonce(state, nonce, &ph);
+  }
+
+  // Given N (>=0) -bytes associated data chunk, this routine absorbs it into
+  // permutation state, continuing from where previous chunk left off.
+  //
+  // Returns false ( doing nothing ), once encryption/ decryption has started.
+  inline bool absorb_ad(const uint8_t* const __restrict data,
+                        const size_t dt_len)
+  {
+    using cyclist::mode_t;
+    constexpr size_t rate = cyclist::R_Kin;
+
+    if (stage != stage_t::AD) {
+      return false;
+    }
+
+    size_t off = 0ul;
+    while (off < dt_len) {
+      // full blocks are absorbed lane-wise, using routines of Cyclist mode
+      if (!open && ((dt_len - off) >= rate)) {
+        cyclist::up<mode_t::Keyed, cyclist::Zero_Color>(
+          state, nullptr, 0ul, &ph);
+
+        if (blk_cnt == 0ul) {
+          cyclist::down<mode_t::Keyed, cyclist::Absorb_Color_Keyed>(
+            state, data + off, rate, &ph);
+        } else {
+          cyclist::down<mode_t::Keyed, cyclist::Zero_Color>(
+            state, data + off, rate, &ph);
+        }
+
+        blk_cnt++;
+        off += rate;
+
+        continue;
+      }
+
+      if (!open) {
+        start_block();
+      }
+
+      const size_t read = std::min(rate - pos, dt_len - off);
+      for (size_t i = 0; i < read; i++) {
+        cyclist::xor_byte(state, pos + i, data[off + i]);
+      }
+
+      pos += read;
+      off += read;
+
+      if (pos == rate) {
+        close_block();
+      }
+    }
+
+    return true;
+  }
+
+  // Given N (>=0) -bytes plain text chunk, this routine computes N -bytes
+  // encrypted chunk, continuing from where previous chunk left off.
+  //
+  // Returns false ( doing nothing ), once decryption has started or tag is
+  // already squeezed.
+  inline bool encrypt_update(const uint8_t* const __restrict text,
+                             uint8_t* const __restrict cipher,
+                             const size_t ct_len)
+  {
+    if ((stage == stage_t::Done) || (dir == dir_t::Decrypt)) {
+      return false;
+    }
+
+    if (stage == stage_t::AD) {
+      end_stage();
+      stage = stage_t::Crypt;
+    }
+
+    dir = dir_t::Encrypt;
+    crypt_chunk<false>(text, cipher, ct_len);
+    return true;
+  }
+
+  // Given N (>=0) -bytes cipher text chunk, this routine computes N -bytes
+  // decrypted chunk, continuing from where previous chunk left off.
+  //
+  // Returns false ( doing nothing ), once encryption has started or tag is
+  // already squeezed.
+  inline bool decrypt_update(const uint8_t* const __restrict cipher,
+                             uint8_t* const __restrict text,
+                             const size_t ct_len)
+  {
+    if ((stage == stage_t::Done) || (dir == dir_t::Encrypt)) {
+      return false;
+    }
+
+    if (stage == stage_t::AD) {
+      end_stage();
+      stage = stage_t::Crypt;
+    }
+
+    dir = dir_t::Decrypt;
+    crypt_chunk<true>(cipher, text, ct_len);
+    return true;
+  }
+
+  // Finishes associated data/ text processing and squeezes 16 -bytes
+  // authentication tag out of permutation state.
+  //
+  // Once called, calling it again doesn't do anything.
+  inline void finalize(uint8_t* const __restrict tag)
+  {
+    if (stage == stage_t::Done) {
+      return;
+    }
+
+    if (stage == stage_t::AD) {
+      end_stage();
+      stage = stage_t::Crypt;
+    }
+
+    end_stage();
+    cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag, 16ul, &ph);
+    stage = stage_t::Done;
+  }
+
+  // Finishes associated data/ text processing and compares ( in constant-time )
+  // squeezed authentication tag against expected one, returning truth value
+  // only when they match.
+  //
+  // Once tag is squeezed, calling it again returns false.
+  inline bool verify(const uint8_t* const __restrict tag)
+  {
+    if (stage == stage_t::Done) {
+      return false;
+    }
+
+    uint8_t tag_[16]{};
+    finalize(tag_);
+
+    uint8_t f = 0;
+    for (size_t i = 0; i < 16; i++) {
+      f |= tag[i] ^ tag_[i];
+    }
+
+    return f == 0;
+  }
+};
+
+}
@@ -0,0 +1,233 @@
+#pragma once
+#include "xoodyak.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Describes single message to be encrypted ( or decrypted ) by
+// `encrypt_batch(...)` ( or `decrypt_batch(...)` ). Different messages can have
+// different associated data and text lengths.
+struct aead_desc_t
+{
+  const uint8_t* key;   // 128 -bit secret key
+  const uint8_t* nonce; // 128 -bit public message nonce
+  const uint8_t* data;  // N (>= 0) -bytes associated data
+  size_t dt_len;        // len(data)
+  const uint8_t* in;    // M (>= 0) -bytes plain text/ cipher text
+  uint8_t* out;         // M (>= 0) -bytes cipher text/ plain text
+  size_t io_len;        // len(in) == len(out)
+  uint8_t* tag;         // 128 -bit authentication tag, computed/ expected
+};
+
+namespace batch {
+
+// Number of associated data blocks, absorbed for a message; empty associated
+// data is absorbed as single empty block
+inline size_t
+ad_blocks(const aead_desc_t& d)
+{
+  constexpr size_t rate = cyclist::R_Kin;
+  return std::max<size_t>(1, (d.dt_len + rate - 1) / rate);
+}
+
+// Number of text blocks, encrypted/ decrypted for a message; empty text is
+// processed as single empty block
+inline size_t
+io_blocks(const aead_desc_t& d)
+{
+  constexpr size_t rate = cyclist::R_Kout;
+  return std::max<size_t>(1, (d.io_len + rate - 1) / rate);
+}
+
+// Cyclist steps ( each one ending in a permutation call ), required for
+// processing a message, i.e. AD blocks + text blocks + tag squeezing
+inline size_t
+step_count(const aead_desc_t& d)
+{
+  return ad_blocks(d) + io_blocks(d) + 1;
+}
+
+// Message, currently being processed by a SIMD lane & where it's at
+struct lane_t
+{
+  size_t desc = 0ul;    // index of message descriptor
+  size_t step = 0ul;    // next Cyclist step to be taken
+  size_t ad_blks = 0ul; // number of associated data blocks
+  size_t io_blks = 0ul; // number of text blocks
+  bool active = false;
+};
+
+// Given N lane-transposed permutation states, this routine encrypts/ decrypts
+// ( based on template parameter's truthness ) n independent messages, of
+// different lengths, by keeping N of them in flight. Each lane takes next
+// message as soon as it's done with current one, so short messages don't stall
+// long ones, while messages are taken in longest-first order, keeping lanes busy
+// till the end.
+//
+// For decryption, verification status of i -th message is written to flags[i],
+// while plain text of a message failing verification is zeroed.
+template<const size_t N, const bool decrypt>
+static inline void
+crypt_batch(const aead_desc_t* const __restrict descs,
+            const size_t n,
+            bool* const __restrict flags)
+{
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0ul);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return step_count(descs[a]) > step_count(descs[b]);
+  });
+
+  alignas(64) uint32_t state[12 * N]{};
+  lane_t lanes[N]{};
+  size_t next = 0ul;
+  size_t active = 0ul;
+
+  // assign next message ( if any ) to j -th lane & absorb key/ nonce into its
+  // permutation state, as `absorb_key()` does
+  auto refill = [&](const size_t j) {
+    if (next == n) {
+      lanes[j].active = false;
+      return;
+    }
+
+    const aead_desc_t& d = descs[order[next]];
+
+    lanes[j].desc = order[next];
+    lanes[j].step = 0ul;
+    lanes[j].ad_blks = ad_blocks(d);
+    lanes[j].io_blks = io_blocks(d);
+    lanes[j].active = true;
+
+    uint8_t msg[33];
+    std::memcpy(msg, d.key, 16);
+    std::memcpy(msg + 16, d.nonce, 16);
+    msg[32] = static_cast<uint8_t>(16);
+
+    for (size_t i = 0; i < 12; i++) {
+      state[i * N + j] = 0u;
+    }
+    cyclist::down_lane<N>(state, j, msg, 33, cyclist::AbsorbKey_Color);
+
+    next++;
+  };
+
+  for (size_t j = 0; j < N; j++) {
+    refill(j);
+    active += lanes[j].active;
+  }
+
+  while (active > 0) {
+    // color to be XORed into state, before permutation, as `up()` does
+    for (size_t j = 0; j < N; j++) {
+      const lane_t& l = lanes[j];
+      if (!l.active || (l.step < l.ad_blks)) {
+        continue;
+      }
+
+      uint8_t color = cyclist::Squeeze_Color;
+      if (l.step == l.ad_blks) {
+        color = cyclist::Crypt_Color;
+      } else if (l.step < l.ad_blks + l.io_blks) {
+        color = cyclist::Zero_Color;
+      }
+
+      state[11 * N + j] ^= static_cast<uint32_t>(color) << 24;
+    }
+
+    xoodoo::permute_batch<N>(state);
+
+    for (size_t j = 0; j < N; j++) {
+      lane_t& l = lanes[j];
+      if (!l.active) {
+        continue;
+      }
+
+      const aead_desc_t& d = descs[l.desc];
+
+      if (l.step < l.ad_blks) {
+        // absorb associated data block
+        const size_t off = l.step * cyclist::R_Kin;
+        const size_t len = std::min(cyclist::R_Kin, d.dt_len - off);
+        const uint8_t color =
+          l.step == 0 ? cyclist::Absorb_Color_Keyed : cyclist::Zero_Color;
+
+        cyclist::down_lane<N>(state, j, d.data + off, len, color);
+      } else if (l.step < l.ad_blks + l.io_blks) {
+        // encrypt/ decrypt text block
+        const size_t off = (l.step - l.ad_blks) * cyclist::R_Kout;
+        const size_t len = std::min(cyclist::R_Kout, d.io_len - off);
+
+        cyclist::crypt_lane<N, decrypt>(state, j, d.in + off, d.out + off, len);
+      } else {
+        // squeeze authentication tag
+        if constexpr (decrypt) {
+          uint8_t tag[16];
+          cyclist::extract_lane<N>(state, j, tag, 16);
+
+          bool f = false;
+          for (size_t i = 0; i < 16; i++) {
+            f |= static_cast<bool>(d.tag[i] ^ tag[i]);
+          }
+
+          // don't release unverified plain text !
+          std::memset(d.out, 0, f * d.io_len);
+          flags[l.desc] = !f;
+        } else {
+          cyclist::extract_lane<N>(state, j, d.tag, 16);
+        }
+
+        refill(j);
+        active -= !lanes[j].active;
+        continue;
+      }
+
+      l.step++;
+    }
+  }
+}
+
+}
+
+// Xoodyak Authenticated Encryption with Associated Data routine, encrypting n
+// independent messages ( each with its own key, nonce, associated data & plain
+// text, of any length ) in a single call, computing cipher text & tag of each.
+//
+// Messages are interleaved across SIMD lanes of multi-state Xoodoo permutation
+// ( 16 lanes with AVX-512, otherwise 8 ), refilling a lane as soon as its
+// message is done. Produces exactly same cipher texts and tags as n independent
+// calls to `encrypt(...)`.
+static inline void
+encrypt_batch(const aead_desc_t* const __restrict descs, const size_t n)
+{
+  if (xoodoo::active_isa() >= xoodoo::isa_t::avx512) {
+    batch::crypt_batch<16, false>(descs, n, nullptr);
+  } else {
+    batch::crypt_batch<8, false>(descs, n, nullptr);
+  }
+}
+
+// Xoodyak Verified Decryption with Associated Data routine, decrypting n
+// independent messages ( each with its own key, nonce, tag, associated data &
+// cipher text, of any length ) in a single call, writing verification status of
+// i -th message to flags[i].
+//
+// Produces exactly same plain texts and flags as n independent calls to
+// `decrypt(...)` i.e. plain text of a message failing verification is zeroed.
+static inline void
+decrypt_batch(const aead_desc_t* const __restrict descs,
+              const size_t n,
+              bool* const __restrict flags)
+{
+  if (xoodoo::active_isa() >= xoodoo::isa_t::avx512) {
+    batch::crypt_batch<16, true>(descs, n, flags);
+  } else {
+    batch::crypt_batch<8, true>(descs, n, flags);
+  }
+}
+
+}
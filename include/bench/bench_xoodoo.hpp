@@ -1,23 +1,41 @@
 #pragma once
 #include "utils.hpp"
 #include "xoodoo.hpp"
+#include "xoodoo_batch.hpp"
 #include <benchmark/benchmark.h>
 
 // Benchmark Xoodyak Authenticated Encryption with Associated Data ( AEAD )
 namespace bench_xoodyak {
 
-// Benchmarks 12 rounds of Xoodoo permutation
+// Benchmarks n ( = 12, by default ) rounds of Xoodoo permutation
+template<const size_t n_rounds = xoodoo::ROUNDS>
 inline void
 xoodoo(benchmark::State& state)
 {
-#if defined __SSE2__ && USE_SSE2 != 0
-  alignas(16)
-#endif
-    uint32_t st[12]{};
+  alignas(16) uint32_t st[12]{};
   xoodyak_utils::random_data(st, 12);
 
   for (auto _ : state) {
-    xoodoo::permute(st);
+    xoodoo::permute<n_rounds>(st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(sizeof(st) * state.iterations());
+}
+
+// Benchmarks n ( = 12, by default ) rounds of Xoodoo permutation, applied on N
+// lane-transposed states at once
+template<const size_t N, const size_t n_rounds = xoodoo::ROUNDS>
+inline void
+xoodoo_xN(benchmark::State& state)
+{
+  alignas(32) uint32_t st[12 * N]{};
+  xoodyak_utils::random_data(st, 12 * N);
+
+  for (auto _ : state) {
+    xoodoo::permute_batch<N, n_rounds>(st);
 
     benchmark::DoNotOptimize(st);
     benchmark::ClobberMemory();
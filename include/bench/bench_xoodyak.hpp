@@ -1,8 +1,19 @@
 #pragma once
+#include "aead_batch.hpp"
+#include "chunked.hpp"
+#include "hash_batch.hpp"
+#include "hash_engine.hpp"
+#include "key_schedule.hpp"
+#include "mac.hpp"
+#include "scatter_gather.hpp"
+#include "session.hpp"
+#include "tree_hash.hpp"
 #include "xoodyak.hpp"
 #include <benchmark/benchmark.h>
 #include <cassert>
 #include <cstring>
+#include <random>
+#include <vector>
 
 // Benchmark Xoodyak Authenticated Encryption with Associated Data ( AEAD )
 namespace bench_xoodyak {
@@ -36,6 +47,67 @@ hash(benchmark::State& state)
   free(digest);
 }
 
+// Benchmark Xoodyak Cryptographic Hash function on CPU, computing digests of N
+// equal length messages at once
+template<const size_t N>
+inline void
+hash_xN(benchmark::State& state)
+{
+  const size_t m_len = state.range(0);
+
+  // allocate memory resources
+  uint8_t* msg = static_cast<uint8_t*>(malloc(N * m_len));
+  uint8_t* digest = static_cast<uint8_t*>(malloc(N * xoodyak::DIGEST_LEN));
+
+  // generate random input bytes for hashing
+  xoodyak_utils::random_data(msg, N * m_len);
+  memset(digest, 0, N * xoodyak::DIGEST_LEN);
+
+  const uint8_t* msg_ptr[N];
+  uint8_t* digest_ptr[N];
+  for (size_t j = 0; j < N; j++) {
+    msg_ptr[j] = msg + j * m_len;
+    digest_ptr[j] = digest + j * xoodyak::DIGEST_LEN;
+  }
+
+  for (auto _ : state) {
+    xoodyak::hash_xN<N>(msg_ptr, m_len, digest_ptr);
+
+    benchmark::DoNotOptimize(msg);
+    benchmark::DoNotOptimize(digest);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(N * m_len * state.iterations()));
+
+  // release memory resources
+  free(msg);
+  free(digest);
+}
+
+// Benchmark Xoodyak based parallel tree hash function on CPU, using all
+// available hardware threads
+inline void
+tree_hash(benchmark::State& state)
+{
+  const size_t m_len = state.range(0);
+
+  std::vector<uint8_t> msg(m_len);
+  uint8_t out[xoodyak::DIGEST_LEN];
+
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  for (auto _ : state) {
+    xoodyak::tree_hash(msg.data(), m_len, out);
+
+    benchmark::DoNotOptimize(msg.data());
+    benchmark::DoNotOptimize(out);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(m_len * state.iterations()));
+}
+
 // Benchmark Xoodyak Authenticated Encryption Algorithm on CPU
 inline void
 encrypt(benchmark::State& state)
@@ -93,6 +165,299 @@ encrypt(benchmark::State& state)
   free(dec);
 }
 
+// Benchmark Xoodyak Authenticated Encryption Algorithm on CPU, where secret key
+// is absorbed once, into a key schedule, which is reused for all messages
+inline void
+encrypt_keyed(benchmark::State& state)
+{
+  const size_t dt_len = state.range(0);
+  const size_t ct_len = state.range(1);
+  constexpr size_t knt_len = 16ul;
+
+  // allocate memory resources
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* tag = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(dt_len));
+  uint8_t* text = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* dec = static_cast<uint8_t*>(std::malloc(ct_len));
+
+  // generate random input bytes for AEAD
+  xoodyak_utils::random_data(key, knt_len);
+  xoodyak_utils::random_data(nonce, knt_len);
+  xoodyak_utils::random_data(data, dt_len);
+  xoodyak_utils::random_data(text, ct_len);
+
+  const xoodyak::key_schedule_t ks(key);
+
+  for (auto _ : state) {
+    ks.encrypt(nonce, data, dt_len, text, enc, ct_len, tag);
+
+    benchmark::DoNotOptimize(nonce);
+    benchmark::DoNotOptimize(data);
+    benchmark::DoNotOptimize(text);
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+
+  bool f = ks.decrypt(nonce, tag, data, dt_len, enc, dec, ct_len);
+
+  assert(f);
+  for (size_t i = 0; i < ct_len; i++) {
+    assert((text[i] ^ dec[i]) == 0u);
+  }
+
+  const size_t per_itr_data = dt_len + ct_len;
+  const size_t total_data = per_itr_data * state.iterations();
+
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+
+  // release memory resources
+  free(key);
+  free(nonce);
+  free(tag);
+  free(data);
+  free(text);
+  free(enc);
+  free(dec);
+}
+
+// Benchmark multi-buffer Xoodyak Authenticated Encryption Algorithm on CPU,
+// sealing a burst of n messages, each with 32 -bytes associated data and plain
+// text of random length ∈ [32, 1024], in a single call
+inline void
+encrypt_batch(benchmark::State& state)
+{
+  const size_t n = state.range(0);
+  constexpr size_t knt_len = 16ul;
+  constexpr size_t dt_len = 32ul;
+
+  std::mt19937_64 gen(n);
+  std::uniform_int_distribution<size_t> dis(32ul, 1024ul);
+
+  std::vector<uint8_t> key(n * knt_len), nonce(n * knt_len), tag(n * knt_len);
+  std::vector<uint8_t> data(n * dt_len);
+  std::vector<std::vector<uint8_t>> text(n), enc(n);
+  std::vector<xoodyak::aead_desc_t> descs(n);
+
+  xoodyak_utils::random_data(key.data(), key.size());
+  xoodyak_utils::random_data(nonce.data(), nonce.size());
+  xoodyak_utils::random_data(data.data(), data.size());
+
+  size_t per_itr_data = 0ul;
+  for (size_t i = 0; i < n; i++) {
+    const size_t ct_len = dis(gen);
+
+    text[i].resize(ct_len);
+    enc[i].resize(ct_len);
+    xoodyak_utils::random_data(text[i].data(), ct_len);
+
+    descs[i] = { key.data() + i * knt_len,   nonce.data() + i * knt_len,
+                 data.data() + i * dt_len,   dt_len,
+                 text[i].data(),             enc[i].data(),
+                 ct_len,                     tag.data() + i * knt_len };
+    per_itr_data += dt_len + ct_len;
+  }
+
+  for (auto _ : state) {
+    xoodyak::encrypt_batch(descs.data(), n);
+
+    benchmark::DoNotOptimize(descs.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t total_data = per_itr_data * state.iterations();
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+}
+
+// Benchmark multi-buffer Xoodyak hash on CPU, hashing a burst of n messages,
+// each of 64 -bytes ( think of fixed width column of records ), in a single
+// call
+inline void
+hash_batch(benchmark::State& state)
+{
+  const size_t n = state.range(0);
+  constexpr size_t m_len = 64ul;
+
+  std::vector<uint8_t> msg(n * m_len), dig(n * xoodyak::DIGEST_LEN);
+  std::vector<const uint8_t*> msg_ptr(n);
+  std::vector<uint8_t*> dig_ptr(n);
+  std::vector<size_t> lens(n, m_len);
+
+  xoodyak_utils::random_data(msg.data(), msg.size());
+
+  for (size_t i = 0; i < n; i++) {
+    msg_ptr[i] = msg.data() + i * m_len;
+    dig_ptr[i] = dig.data() + i * xoodyak::DIGEST_LEN;
+  }
+
+  for (auto _ : state) {
+    xoodyak::hash_batch(msg_ptr.data(), lens.data(), dig_ptr.data(), n);
+
+    benchmark::DoNotOptimize(dig.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t total = msg.size() * state.iterations();
+  state.SetBytesProcessed(static_cast<int64_t>(total));
+}
+
+// Benchmark Xoodyak parallel batch hashing engine on CPU, hashing n messages of
+// skewed lengths ( mostly 0..256 -bytes ones, while every 256 -th one is of
+// 64 KiB ), either using engine ( with all available hardware threads ) or
+// one message after another, for comparison
+inline void
+hash_engine(benchmark::State& state)
+{
+  const size_t n = state.range(0);
+  const bool use_engine = state.range(1) != 0;
+
+  std::mt19937_64 gen(n);
+  std::uniform_int_distribution<size_t> dis(0ul, 256ul);
+
+  std::vector<size_t> lens(n);
+  size_t total_len = 0ul;
+  for (size_t i = 0; i < n; i++) {
+    lens[i] = (i & 255ul) == 255ul ? (64ul << 10) : dis(gen);
+    total_len += lens[i];
+  }
+
+  std::vector<uint8_t> msg(total_len), dig(n * xoodyak::DIGEST_LEN);
+  std::vector<const uint8_t*> msg_ptr(n);
+  std::vector<uint8_t*> dig_ptr(n);
+
+  xoodyak_utils::random_data(msg.data(), msg.size());
+
+  for (size_t i = 0, off = 0; i < n; off += lens[i], i++) {
+    msg_ptr[i] = msg.data() + off;
+    dig_ptr[i] = dig.data() + i * xoodyak::DIGEST_LEN;
+  }
+
+  xoodyak::hash_engine_t engine;
+
+  for (auto _ : state) {
+    if (use_engine) {
+      engine.hash(msg_ptr.data(), lens.data(), dig_ptr.data(), n);
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        xoodyak::hash(msg_ptr[i], lens[i], dig_ptr[i]);
+      }
+    }
+
+    benchmark::DoNotOptimize(dig.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t total = total_len * state.iterations();
+  state.SetBytesProcessed(static_cast<int64_t>(total));
+}
+
+// Benchmark in-place Xoodyak Authenticated Encryption Algorithm on CPU
+inline void
+encrypt_inplace(benchmark::State& state)
+{
+  const size_t dt_len = state.range(0);
+  const size_t ct_len = state.range(1);
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len);
+  std::vector<uint8_t> data(dt_len), buf(ct_len);
+
+  // generate random input bytes for AEAD
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(buf.data(), ct_len);
+
+  for (auto _ : state) {
+    xoodyak::encrypt_inplace(key.data(),
+                             nonce.data(),
+                             data.data(),
+                             dt_len,
+                             buf.data(),
+                             ct_len,
+                             tag.data());
+
+    benchmark::DoNotOptimize(buf.data());
+    benchmark::DoNotOptimize(tag.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t per_itr_data = dt_len + ct_len;
+  const size_t total_data = per_itr_data * state.iterations();
+
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+}
+
+// Benchmark Xoodyak message authentication code on CPU, computing 16 -bytes tag
+// of message of given length
+inline void
+mac(benchmark::State& state)
+{
+  const size_t m_len = state.range(0);
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), msg(m_len), tag(knt_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  for (auto _ : state) {
+    xoodyak::mac(key.data(), msg.data(), m_len, tag.data(), knt_len);
+
+    benchmark::DoNotOptimize(tag.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(m_len * state.iterations()));
+}
+
+// Benchmark multi-buffer Xoodyak message authentication code on CPU, computing
+// 16 -bytes tags of a burst of n messages, each of random length ∈ [32, 1024],
+// in a single call
+inline void
+mac_batch(benchmark::State& state)
+{
+  const size_t n = state.range(0);
+  constexpr size_t knt_len = 16ul;
+
+  std::mt19937_64 gen(n);
+  std::uniform_int_distribution<size_t> dis(32ul, 1024ul);
+
+  std::vector<uint8_t> key(n * knt_len), tag(n * knt_len);
+  std::vector<std::vector<uint8_t>> msg(n);
+  std::vector<xoodyak::mac_desc_t> descs(n);
+
+  xoodyak_utils::random_data(key.data(), key.size());
+
+  size_t per_itr_data = 0ul;
+  for (size_t i = 0; i < n; i++) {
+    const size_t m_len = dis(gen);
+
+    msg[i].resize(m_len);
+    xoodyak_utils::random_data(msg[i].data(), m_len);
+
+    descs[i] = { key.data() + i * knt_len,
+                 msg[i].data(),
+                 m_len,
+                 tag.data() + i * knt_len,
+                 knt_len };
+    per_itr_data += m_len;
+  }
+
+  for (auto _ : state) {
+    xoodyak::mac_batch(descs.data(), n);
+
+    benchmark::DoNotOptimize(tag.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t total_data = per_itr_data * state.iterations();
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+}
+
 // Benchmark Xoodyak Verified Decryption Algorithm on CPU
 inline void
 decrypt(benchmark::State& state)
@@ -151,4 +516,156 @@ decrypt(benchmark::State& state)
   free(dec);
 }
 
+// Benchmark Xoodyak session mode on CPU, sealing frames with fixed length
+// associated data & variable length plain text, on a long-lived session, so
+// that secret key & nonce are never absorbed again
+inline void
+session_seal(benchmark::State& state)
+{
+  const size_t dt_len = state.range(0);
+  const size_t ct_len = state.range(1);
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len);
+  std::vector<uint8_t> data(dt_len), text(ct_len), enc(ct_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(text.data(), ct_len);
+
+  xoodyak::session_t s(key.data(), nonce.data());
+
+  for (auto _ : state) {
+    s.seal(data.data(), dt_len, text.data(), enc.data(), ct_len, tag.data());
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::DoNotOptimize(tag.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t per_itr = dt_len + ct_len;
+  state.SetBytesProcessed(static_cast<int64_t>(per_itr * state.iterations()));
+}
+
+// Benchmark Xoodyak verified decryption on CPU, when authentication tag doesn't
+// match ( i.e. forged/ corrupted input ), comparing `decrypt(...)`, which writes
+// plain text & then zeroes it, against `verify_then_decrypt(...)`, which never
+// writes it, based on template parameter's truthness
+template<const bool verify_first>
+inline void
+decrypt_forged(benchmark::State& state)
+{
+  const size_t dt_len = state.range(0);
+  const size_t ct_len = state.range(1);
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len);
+  std::vector<uint8_t> data(dt_len), enc(ct_len), dec(ct_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(tag.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(enc.data(), ct_len);
+
+  for (auto _ : state) {
+    bool f = false;
+
+    if constexpr (verify_first) {
+      f = xoodyak::verify_then_decrypt(key.data(),
+                                       nonce.data(),
+                                       tag.data(),
+                                       data.data(),
+                                       dt_len,
+                                       enc.data(),
+                                       dec.data(),
+                                       ct_len);
+    } else {
+      f = xoodyak::decrypt(key.data(),
+                           nonce.data(),
+                           tag.data(),
+                           data.data(),
+                           dt_len,
+                           enc.data(),
+                           dec.data(),
+                           ct_len);
+    }
+    assert(!f);
+
+    benchmark::DoNotOptimize(dec.data());
+    benchmark::DoNotOptimize(f);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t per_itr = dt_len + ct_len;
+  state.SetBytesProcessed(static_cast<int64_t>(per_itr * state.iterations()));
+}
+
+// Benchmark Xoodyak scatter-gather AEAD encrypt routine on CPU, with 32 -bytes
+// associated data & plain text of given length, split into 1500 -bytes ( i.e.
+// Ethernet MTU sized ) segments, while cipher text is kept contiguous
+inline void
+encryptv(benchmark::State& state)
+{
+  const size_t ct_len = state.range(0);
+  constexpr size_t dt_len = 32ul;
+  constexpr size_t seg_len = 1500ul;
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len);
+  std::vector<uint8_t> data(dt_len), text(ct_len), enc(ct_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(text.data(), ct_len);
+
+  const xoodyak::sg::in_seg_t data_segs[]{ data };
+  const xoodyak::sg::out_seg_t enc_segs[]{ enc };
+  std::vector<xoodyak::sg::in_seg_t> text_segs;
+
+  for (size_t off = 0; off < ct_len; off += seg_len) {
+    text_segs.emplace_back(text.data() + off, std::min(seg_len, ct_len - off));
+  }
+
+  for (auto _ : state) {
+    xoodyak::encryptv(
+      key.data(), nonce.data(), data_segs, text_segs, enc_segs, tag.data());
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::DoNotOptimize(tag.data());
+    benchmark::ClobberMemory();
+  }
+
+  const size_t per_itr = dt_len + ct_len;
+  state.SetBytesProcessed(static_cast<int64_t>(per_itr * state.iterations()));
+}
+
+// Benchmark chunked Xoodyak AEAD, sealing N -bytes random payload into framed
+// container, using default chunk length, on all available hardware threads
+inline void
+seal_chunked(benchmark::State& state)
+{
+  const size_t m_len = state.range(0);
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), msg(m_len);
+  std::vector<uint8_t> sealed(xoodyak::chunked_sealed_len(m_len));
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  for (auto _ : state) {
+    xoodyak::seal_chunked(
+      key.data(), nonce.data(), msg.data(), m_len, sealed.data());
+
+    benchmark::DoNotOptimize(sealed.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(m_len * state.iterations()));
+}
+
 }
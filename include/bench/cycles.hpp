@@ -0,0 +1,246 @@
+#pragma once
+#include "xoodoo.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined XOODOO_X86
+#include <x86intrin.h>
+#endif
+
+#if defined __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Cycle counters & latency statistics, used by cycles-per-byte benchmark
+// harness ( see `bench/cycles.cpp` ), which, unlike google-benchmark based
+// one, times each call on its own, so that latency distribution ( not just
+// mean throughput ) can be reported
+namespace bench_cycles {
+
+// Source of timestamps, read before & after each timed call
+enum class counter_t : uint8_t
+{
+  tsc,  // time stamp counter ( read using RDTSC/ RDTSCP ), ticking at constant
+        // reference frequency, irrespective of current core frequency
+  perf, // core clock cycles, counted by hardware performance counter, set up
+        // using `perf_event_open(2)`
+  clock // nanoseconds of monotonic clock, when neither of above is available
+};
+
+inline const char*
+counter_name(const counter_t c)
+{
+  switch (c) {
+    case counter_t::tsc:
+      return "tsc";
+    case counter_t::perf:
+      return "perf";
+    default:
+      return "clock";
+  }
+}
+
+// Reads timestamp, before timed call begins; LFENCE keeps preceding
+// instructions from being executed after counter is read
+#if defined XOODOO_X86
+static inline uint64_t
+tsc_start()
+{
+  _mm_lfence();
+  const uint64_t t = __rdtsc();
+  _mm_lfence();
+  return t;
+}
+
+// Reads timestamp, after timed call ends; RDTSCP waits for all preceding
+// instructions, while LFENCE keeps following ones from being executed before
+// counter is read
+static inline uint64_t
+tsc_stop()
+{
+  uint32_t aux;
+  const uint64_t t = __rdtscp(&aux);
+  _mm_lfence();
+  return t;
+}
+#endif
+
+static inline uint64_t
+clock_now()
+{
+  using namespace std::chrono;
+  const auto t = steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(duration_cast<nanoseconds>(t).count());
+}
+
+// Counter of elapsed ticks ( cycles or nanoseconds ), which prefers TSC, when
+// available, unless core cycles are asked for, in which case it falls back to
+// TSC ( or monotonic clock ), if performance counter can't be opened ( say,
+// due to `perf_event_paranoid` setting or lack of PMU access, inside VMs )
+struct ticker_t
+{
+  counter_t src = counter_t::clock;
+  int fd = -1;
+
+  inline explicit ticker_t(const bool core_cycles)
+  {
+#if defined __linux__
+    if (core_cycles) {
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+
+      const long r = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      fd = static_cast<int>(r);
+      if (fd >= 0) {
+        src = counter_t::perf;
+        return;
+      }
+    }
+#else
+    (void)core_cycles;
+#endif
+
+#if defined XOODOO_X86
+    src = counter_t::tsc;
+#endif
+  }
+
+  inline ~ticker_t()
+  {
+#if defined __linux__
+    if (fd >= 0) {
+      ::close(fd);
+    }
+#endif
+  }
+
+  ticker_t(const ticker_t&) = delete;
+  ticker_t& operator=(const ticker_t&) = delete;
+
+  inline uint64_t start() const
+  {
+    switch (src) {
+#if defined XOODOO_X86
+      case counter_t::tsc:
+        return tsc_start();
+#endif
+#if defined __linux__
+      case counter_t::perf:
+        return read_perf();
+#endif
+      default:
+        return clock_now();
+    }
+  }
+
+  inline uint64_t stop() const
+  {
+    switch (src) {
+#if defined XOODOO_X86
+      case counter_t::tsc:
+        return tsc_stop();
+#endif
+#if defined __linux__
+      case counter_t::perf:
+        return read_perf();
+#endif
+      default:
+        return clock_now();
+    }
+  }
+
+  // Ticks of this counter per nanosecond, estimated against monotonic clock,
+  // over ~50ms, which is meaningful only for TSC, as it ticks at constant rate
+  inline double ticks_per_ns() const
+  {
+    if (src != counter_t::tsc) {
+      return src == counter_t::clock ? 1.0 : 0.0;
+    }
+
+    const uint64_t c0 = clock_now();
+    const uint64_t t0 = start();
+    while (clock_now() - c0 < 50'000'000ul) {
+    }
+    const uint64_t c1 = clock_now();
+    const uint64_t t1 = stop();
+
+    return static_cast<double>(t1 - t0) / static_cast<double>(c1 - c0);
+  }
+
+  // Smallest # -of ticks, measured between back-to-back start & stop, which is
+  // subtracted from each sample
+  inline uint64_t overhead() const
+  {
+    uint64_t min = UINT64_MAX;
+    for (size_t i = 0; i < 10000; i++) {
+      const uint64_t t0 = start();
+      const uint64_t t1 = stop();
+      min = std::min(min, t1 - t0);
+    }
+
+    return min;
+  }
+
+private:
+#if defined __linux__
+  inline uint64_t read_perf() const
+  {
+    uint64_t v = 0ul;
+    if (::read(fd, &v, sizeof(v)) != sizeof(v)) {
+      return 0ul;
+    }
+    return v;
+  }
+#endif
+};
+
+// Summary of latency samples ( in ticks ) of a single benchmark case
+struct stats_t
+{
+  uint64_t min;
+  uint64_t p50;
+  uint64_t p99;
+  uint64_t p999;
+  uint64_t max;
+  double mean;
+};
+
+// Given q ∈ [0, 1], returns q -th quantile of sorted samples, using nearest
+// rank method
+static inline uint64_t
+quantile(const std::vector<uint64_t>& sorted, const double q)
+{
+  const size_t n = sorted.size();
+  const size_t r = static_cast<size_t>(std::ceil(q * static_cast<double>(n)));
+  return sorted[std::clamp<size_t>(r, 1, n) - 1];
+}
+
+// Sorts ( non-empty ) samples in place & summarizes them
+static inline stats_t
+summarize(std::vector<uint64_t>& samples)
+{
+  std::sort(samples.begin(), samples.end());
+
+  double sum = 0.0;
+  for (const uint64_t s : samples) {
+    sum += static_cast<double>(s);
+  }
+
+  return stats_t{ samples.front(),
+                  quantile(samples, 0.5),
+                  quantile(samples, 0.99),
+                  quantile(samples, 0.999),
+                  samples.back(),
+                  sum / static_cast<double>(samples.size()) };
+}
+
+}
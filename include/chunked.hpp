@@ -0,0 +1,410 @@
+#pragma once
+#include "parallel.hpp"
+#include "xoodyak.hpp"
+#include <algorithm>
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Payload is split into chunks of this many bytes ( last one can be shorter ),
+// by default, each of them sealed independently, by `seal_chunked(...)`
+constexpr size_t CHUNKED_CHUNK_LEN = 65536ul;
+
+// Sealed container starts with header of these many bytes, which is followed
+// by sealed chunks, each of them being cipher text, followed by 16 -bytes tag
+constexpr size_t CHUNKED_HEADER_LEN = 40ul;
+
+namespace chunked {
+
+// Magic bytes & format version, at beginning of container header
+constexpr uint8_t MAGIC[4]{ 'X', 'D', 'Y', 'C' };
+constexpr uint8_t VERSION = 1u;
+
+// Parameters of sealed container, as recorded in its header
+struct header_t
+{
+  size_t m_len;     // length of payload
+  size_t chunk_len; // length of each chunk, except last one
+  size_t chunks;    // # -of chunks ( empty payload forms single empty chunk )
+};
+
+static inline void
+to_le64(const uint64_t v, uint8_t* const bytes)
+{
+  for (size_t i = 0; i < 8; i++) {
+    bytes[i] = static_cast<uint8_t>(v >> (i << 3));
+  }
+}
+
+static inline uint64_t
+from_le64(const uint8_t* const bytes)
+{
+  uint64_t v = 0ul;
+  for (size_t i = 0; i < 8; i++) {
+    v |= static_cast<uint64_t>(bytes[i]) << (i << 3);
+  }
+
+  return v;
+}
+
+// Returns # -of chunks, payload of given length is split into
+static inline size_t
+num_chunks(const size_t m_len, const size_t chunk_len)
+{
+  const size_t n = m_len / chunk_len;
+  return std::max<size_t>(1, n + static_cast<size_t>(m_len % chunk_len != 0));
+}
+
+// Writes container header i.e. `magic || version || 0x000000 ||
+// le64(m_len) || le64(chunk_len) || base nonce`
+static inline void
+write_header(const uint8_t* const __restrict nonce,
+             const size_t m_len,
+             const size_t chunk_len,
+             uint8_t* const __restrict hdr)
+{
+  std::memcpy(hdr, MAGIC, sizeof(MAGIC));
+  hdr[4] = VERSION;
+  std::memset(hdr + 5, 0, 3);
+
+  to_le64(m_len, hdr + 8);
+  to_le64(chunk_len, hdr + 16);
+  std::memcpy(hdr + 24, nonce, 16);
+}
+
+// Parses container header, returning truth value only when it's well-formed
+// and container is of exactly the length, header says it should be
+static inline bool
+read_header(const uint8_t* const __restrict sealed,
+            const size_t s_len,
+            header_t* const __restrict hdr)
+{
+  if (s_len < CHUNKED_HEADER_LEN) {
+    return false;
+  }
+
+  const bool magic = std::memcmp(sealed, MAGIC, sizeof(MAGIC)) == 0;
+  const bool version = (sealed[4] == VERSION) && (sealed[5] == 0) &&
+                       (sealed[6] == 0) && (sealed[7] == 0);
+  if (!magic || !version) {
+    return false;
+  }
+
+  const uint64_t m_len = from_le64(sealed + 8);
+  const uint64_t chunk_len = from_le64(sealed + 16);
+
+  // payload can't be longer than container, so that computing expected
+  // container length can't overflow
+  if ((chunk_len == 0) || (m_len > s_len)) {
+    return false;
+  }
+
+  hdr->m_len = m_len;
+  hdr->chunk_len = chunk_len;
+  hdr->chunks = num_chunks(m_len, chunk_len);
+
+  return s_len == (CHUNKED_HEADER_LEN + m_len + hdr->chunks * 16);
+}
+
+// Derives nonce of i -th chunk, by XORing le64(i) into first 8 -bytes of base
+// nonce
+static inline void
+chunk_nonce(const uint8_t* const __restrict base,
+            const size_t idx,
+            uint8_t* const __restrict nonce)
+{
+  uint8_t ctr[8];
+  to_le64(idx, ctr);
+
+  std::memcpy(nonce, base, 16);
+  for (size_t i = 0; i < 8; i++) {
+    nonce[i] ^= ctr[i];
+  }
+}
+
+// Seals/ opens ( based on template parameter's truthness ) all chunks, in
+// [from, to), where full chunks are processed in groups of N, using
+// multi-message AEAD, while remaining ones are processed one at a time. Returns
+// false, when opening & any of those chunks fails verification.
+//
+// Header ( which holds base nonce ) is associated data of every chunk, while
+// `in`/ `out` point to beginning of payload and sealed chunks, when sealing (
+// and the other way around, when opening ).
+template<const size_t N, const bool open>
+static inline bool
+process_chunks(const uint8_t* const __restrict key,
+               const uint8_t* const __restrict hdr,
+               const header_t& h,
+               const uint8_t* const __restrict in,
+               uint8_t* const __restrict out,
+               const size_t from,
+               const size_t to)
+{
+  const uint8_t* const base = hdr + 24;
+  const size_t full = h.m_len / h.chunk_len;
+  const size_t stride = h.chunk_len + 16;
+
+  // offsets of i -th chunk in payload and in sealed chunks
+  auto p_off = [&](const size_t i) { return i * h.chunk_len; };
+  auto s_off = [&](const size_t i) { return i * stride; };
+
+  bool ok = true;
+
+  size_t i = from;
+  while (i < to) {
+    if ((i + N <= to) && (i + N <= full)) {
+      uint8_t nonce[N][16];
+      const uint8_t* key_[N];
+      const uint8_t* nonce_[N];
+      const uint8_t* hdr_[N];
+      const uint8_t* in_[N];
+      uint8_t* out_[N];
+      const uint8_t* tag_in[N];
+      uint8_t* tag_out[N];
+
+      for (size_t j = 0; j < N; j++) {
+        chunk_nonce(base, i + j, nonce[j]);
+
+        key_[j] = key;
+        nonce_[j] = nonce[j];
+        hdr_[j] = hdr;
+
+        if constexpr (open) {
+          in_[j] = in + s_off(i + j);
+          tag_in[j] = in + s_off(i + j) + h.chunk_len;
+          out_[j] = out + p_off(i + j);
+        } else {
+          in_[j] = in + p_off(i + j);
+          out_[j] = out + s_off(i + j);
+          tag_out[j] = out + s_off(i + j) + h.chunk_len;
+        }
+      }
+
+      if constexpr (open) {
+        bool flag[N];
+        decrypt_xN<N>(key_,
+                      nonce_,
+                      tag_in,
+                      hdr_,
+                      CHUNKED_HEADER_LEN,
+                      in_,
+                      out_,
+                      h.chunk_len,
+                      flag);
+
+        for (size_t j = 0; j < N; j++) {
+          ok &= flag[j];
+        }
+      } else {
+        encrypt_xN<N>(key_,
+                      nonce_,
+                      hdr_,
+                      CHUNKED_HEADER_LEN,
+                      in_,
+                      out_,
+                      h.chunk_len,
+                      tag_out);
+      }
+
+      i += N;
+    } else {
+      uint8_t nonce[16];
+      chunk_nonce(base, i, nonce);
+
+      const size_t len = std::min(h.chunk_len, h.m_len - p_off(i));
+
+      if constexpr (open) {
+        ok &= decrypt(key,
+                      nonce,
+                      in + s_off(i) + len,
+                      hdr,
+                      CHUNKED_HEADER_LEN,
+                      in + s_off(i),
+                      out + p_off(i),
+                      len);
+      } else {
+        encrypt(key,
+                nonce,
+                hdr,
+                CHUNKED_HEADER_LEN,
+                in + p_off(i),
+                out + s_off(i),
+                len,
+                out + s_off(i) + len);
+      }
+
+      i += 1;
+    }
+  }
+
+  return ok;
+}
+
+// Seals/ opens ( based on template parameter's truthness ) all chunks, on
+// `n_threads` worker threads, each of them processing 16 ( with AVX-512,
+// otherwise 8 ) chunks at once
+template<const bool open>
+static inline bool
+process_all(const uint8_t* const __restrict key,
+            const uint8_t* const __restrict hdr,
+            const header_t& h,
+            const uint8_t* const __restrict in,
+            uint8_t* const __restrict out,
+            const size_t n_threads)
+{
+  const bool wide = xoodoo::active_isa() >= xoodoo::isa_t::avx512;
+  const size_t group = wide ? 16 : 8;
+
+  std::atomic<bool> ok{ true };
+
+  auto work = [&](const size_t from, const size_t to) {
+    bool f;
+    if (wide) {
+      f = process_chunks<16, open>(key, hdr, h, in, out, from, to);
+    } else {
+      f = process_chunks<8, open>(key, hdr, h, in, out, from, to);
+    }
+
+    if (!f) {
+      ok.store(false, std::memory_order_relaxed);
+    }
+  };
+
+  xoodyak_utils::parallel_for(h.chunks, group, n_threads, work);
+  return ok.load(std::memory_order_relaxed);
+}
+
+}
+
+// Returns length of sealed container, for payload of given length, split into
+// chunks of given length
+static inline size_t
+chunked_sealed_len(const size_t m_len,
+                   const size_t chunk_len = CHUNKED_CHUNK_LEN)
+{
+  return CHUNKED_HEADER_LEN + m_len +
+         chunked::num_chunks(m_len, chunk_len) * 16;
+}
+
+// Chunked Xoodyak AEAD, for large payloads, which splits N -bytes payload into
+// `chunk_len` -bytes chunks ( last one can be shorter; empty payload forms
+// single empty chunk ) and seals each of them independently, same as
+// `encrypt(...)` does, on `n_threads` worker threads ( 0 denotes all available
+// hardware threads ), into self-describing container of
+// `chunked_sealed_len(N, chunk_len)` -bytes
+//
+// header ( 40 -bytes ) || cipher_0 || tag_0 || ... || cipher_{n-1} || tag_{n-1}
+//
+// where header = "XDYC" || version ( = 1 ) || 0x000000 || le64(N) ||
+// le64(chunk_len) || nonce. i -th chunk is sealed under nonce, with le64(i)
+// XORed into its first 8 -bytes, while whole header is its associated data, so
+// that chunks can neither be reordered nor moved between containers, while
+// tampering with header ( say, truncating payload length ) fails verification
+// of every chunk.
+//
+// Returns false ( doing nothing ), if chunk length is 0.
+static inline bool
+seal_chunked(const uint8_t* const __restrict key,   // 128 -bit secret key
+             const uint8_t* const __restrict nonce, // 128 -bit base nonce
+             const uint8_t* const __restrict msg,   // N (>=0) -bytes payload
+             const size_t m_len,                    // len(msg)
+             uint8_t* const __restrict out,         // sealed container
+             const size_t chunk_len = CHUNKED_CHUNK_LEN, // len(chunk)
+             const size_t n_threads = 0ul // # -of worker threads
+)
+{
+  if (chunk_len == 0ul) {
+    return false;
+  }
+
+  chunked::write_header(nonce, m_len, chunk_len, out);
+
+  const size_t chunks = chunked::num_chunks(m_len, chunk_len);
+  const chunked::header_t h{ m_len, chunk_len, chunks };
+  return chunked::process_all<false>(
+    key, out, h, msg, out + CHUNKED_HEADER_LEN, n_threads);
+}
+
+// Given sealed container, this routine writes length of payload and # -of
+// chunks, held in it, returning truth value only when container header is
+// well-formed and container length matches it. Header isn't authenticated,
+// until a chunk is opened.
+static inline bool
+chunked_info(const uint8_t* const __restrict sealed, // sealed container
+             const size_t s_len,                     // len(sealed)
+             size_t* const __restrict m_len,         // len(payload)
+             size_t* const __restrict chunks         // # -of chunks
+)
+{
+  chunked::header_t h;
+  if (!chunked::read_header(sealed, s_len, &h)) {
+    return false;
+  }
+
+  *m_len = h.m_len;
+  *chunks = h.chunks;
+  return true;
+}
+
+// Opens whole sealed container, on `n_threads` worker threads ( 0 denotes all
+// available hardware threads ), writing payload ( of length, as reported by
+// `chunked_info(...)` ) to `out`, returning truth value only when container is
+// well-formed and every chunk passes verification.
+//
+// Note, if any chunk fails verification, whole payload is zeroed.
+static inline bool
+open_chunked(const uint8_t* const __restrict key,    // 128 -bit secret key
+             const uint8_t* const __restrict sealed, // sealed container
+             const size_t s_len,                     // len(sealed)
+             uint8_t* const __restrict out,          // N -bytes payload
+             const size_t n_threads = 0ul            // # -of worker threads
+)
+{
+  chunked::header_t h;
+  if (!chunked::read_header(sealed, s_len, &h)) {
+    return false;
+  }
+
+  const bool ok = chunked::process_all<true>(
+    key, sealed, h, sealed + CHUNKED_HEADER_LEN, out, n_threads);
+
+  // don't release unverified payload !
+  std::memset(out, 0, !ok * h.m_len);
+  return ok;
+}
+
+// Opens only i -th chunk of sealed container ( i.e. random access ), writing
+// its plain text ( at max chunk length -bytes ) to `out` and its length to
+// `o_len`, returning truth value only when container is well-formed, chunk
+// exists and passes verification.
+//
+// Note, if verification fails, plain text is zeroed.
+static inline bool
+open_chunk(const uint8_t* const __restrict key,    // 128 -bit secret key
+           const uint8_t* const __restrict sealed, // sealed container
+           const size_t s_len,                     // len(sealed)
+           const size_t idx,                       // chunk index
+           uint8_t* const __restrict out,          // chunk plain text
+           size_t* const __restrict o_len          // len(out)
+)
+{
+  chunked::header_t h;
+  if (!chunked::read_header(sealed, s_len, &h) || (idx >= h.chunks)) {
+    return false;
+  }
+
+  uint8_t nonce[16];
+  chunked::chunk_nonce(sealed + 24, idx, nonce);
+
+  const size_t off = idx * h.chunk_len;
+  const size_t len = std::min(h.chunk_len, h.m_len - off);
+  const uint8_t* const blk =
+    sealed + CHUNKED_HEADER_LEN + idx * (h.chunk_len + 16);
+
+  *o_len = len;
+  return decrypt(
+    key, nonce, blk + len, sealed, CHUNKED_HEADER_LEN, blk, out, len);
+}
+
+}
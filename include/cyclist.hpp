@@ -72,6 +72,22 @@ constexpr uint8_t Ratchet_Color = 0x10u;
 // Color value used when no domain seperation is required
 constexpr uint8_t Zero_Color = 0x00u;
 
+// Given byte index i ∈ [0, 48), this routine returns i -th byte of 384 -bit
+// permutation state, when it's interpreted as little endian byte array
+static inline uint8_t
+get_byte(const uint32_t* const state, const size_t i)
+{
+  return static_cast<uint8_t>(state[i >> 2] >> ((i & 3ul) << 3));
+}
+
+// Given byte index i ∈ [0, 48), this routine XORs byte `b` into i -th byte of
+// 384 -bit permutation state, when it's interpreted as little endian byte array
+static inline void
+xor_byte(uint32_t* const state, const size_t i, const uint8_t b)
+{
+  state[i >> 2] ^= static_cast<uint32_t>(b) << ((i & 3ul) << 3);
+}
+
 // Internal function used in Cyclist mode of operation, which consumes N -bytes
 //
 // See `Inside Cyclist` in section 2.2 of Xoodyak specification
@@ -154,6 +170,60 @@ up(uint32_t* const __restrict state,
   ph[0] = phase_t::Up;
 }
 
+// Full block variant of `down()`, where block length ( = rate of Cyclist mode
+// i.e. one of 16, 24, 44 ) is known at compile-time, so that whole lanes are
+// XORed into permutation state, in a fully unrolled loop
+template<const mode_t m, const uint8_t color, const size_t b_len>
+static inline void
+down_full(uint32_t* const __restrict state,
+          const uint8_t* const __restrict blk,
+          phase_t* const __restrict ph)
+{
+  static_assert((b_len & 3ul) == 0ul && b_len < 48ul, "Must be a full rate !");
+
+#if defined __clang__
+#pragma clang loop unroll(enable)
+#elif defined __GNUG__
+#pragma GCC unroll 11
+#endif
+  for (size_t i = 0; i < (b_len >> 2); i++) {
+    state[i] ^= xoodyak_utils::from_le_bytes(blk + (i << 2));
+  }
+
+  state[b_len >> 2] ^= 0x01u;
+  state[11] ^= static_cast<uint32_t>(color) << 24;
+  ph[0] = phase_t::Down;
+}
+
+// Full block variant of `up()`, where output length ( = rate of Cyclist mode
+// i.e. one of 16, 24 ) is known at compile-time, so that whole lanes are
+// written to output, in a fully unrolled loop
+template<const mode_t m, const uint8_t color, const size_t b_len>
+static inline void
+up_full(uint32_t* const __restrict state,
+        uint8_t* const __restrict blk,
+        phase_t* const __restrict ph)
+{
+  static_assert((b_len & 3ul) == 0ul && b_len < 48ul, "Must be a full rate !");
+
+  if constexpr (m == mode_t::Keyed) {
+    state[11] ^= static_cast<uint32_t>(color) << 24;
+  }
+
+  xoodoo::permute(state);
+
+#if defined __clang__
+#pragma clang loop unroll(enable)
+#elif defined __GNUG__
+#pragma GCC unroll 11
+#endif
+  for (size_t i = 0; i < (b_len >> 2); i++) {
+    xoodyak_utils::to_le_bytes(state[i], blk + (i << 2));
+  }
+
+  ph[0] = phase_t::Up;
+}
+
 // Internal function used in Cyclist mode of operation, which absorbs N -many
 // bytes into permutation state
 //
@@ -175,14 +245,22 @@ absorb_any(uint32_t* const __restrict state,    // 384 -bit permutation state
   }
 
   const size_t read = std::min(rate, m_len);
-  down<m, color>(state, msg, read, ph);
+  if (read == rate) {
+    down_full<m, color, rate>(state, msg, ph);
+  } else {
+    down<m, color>(state, msg, read, ph);
+  }
 
   size_t boff = read;
   while (boff < m_len) {
     up<m, Zero_Color>(state, nullptr, 0ul, ph);
 
     const size_t read = std::min(rate, m_len - boff);
-    down<m, Zero_Color>(state, msg + boff, read, ph);
+    if (read == rate) {
+      down_full<m, Zero_Color, rate>(state, msg + boff, ph);
+    } else {
+      down<m, Zero_Color>(state, msg + boff, read, ph);
+    }
 
     boff += read;
   }
@@ -221,7 +299,11 @@ squeeze_any(uint32_t* const __restrict state, // 384 -bit permutation state
     down<m, Zero_Color>(state, nullptr, 0ul, ph);
 
     const size_t tmp = std::min(o_len - l, rate);
-    up<m, Zero_Color>(state, out + l, tmp, ph);
+    if (tmp == rate) {
+      up_full<m, Zero_Color, rate>(state, out + l, ph);
+    } else {
+      up<m, Zero_Color>(state, out + l, tmp, ph);
+    }
     l += tmp;
   }
 }
@@ -250,61 +332,224 @@ absorb_key(
   absorb_any<mode_t::Keyed, R_Kin, AbsorbKey_Color>(state, msg, 33ul, ph);
 }
 
-// Internal function used in Cyclist mode of operation, which encrypts plain
-// text/ decrypts cipher text ( based on template parameter's truthness )
+// Internal function used in Cyclist mode of operation, which absorbs 128 -bit
+// secret key, with empty identifier, into permutation state i.e. `key || 0x00`
+// is absorbed, which is what message authentication code needs, as there's no
+// nonce to absorb
 //
 // See algorithmic definition in algorithm 3 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-template<const bool decrypt>
 static inline void
-crypt(uint32_t* const __restrict state,   // 384 -bit permutation state
-      const uint8_t* const __restrict in, // N -bytes input message
-      uint8_t* const __restrict out,      // N -bytes output message
-      const size_t io_len,                // len(in) == len(out) == N | N >= 0
-      phase_t* const __restrict ph        // phase of cyclist mode of operation
+absorb_key(uint32_t* const __restrict state,    // 384 -bit permutation state
+           const uint8_t* const __restrict key, // 128 -bit secret key
+           phase_t* const __restrict ph         // phase of cyclist mode
 )
 {
-  // compulsory part of crypt routine, doesn't matter whether io_len != 0
-  const size_t read = std::min(R_Kout, io_len);
-  up<mode_t::Keyed, Crypt_Color>(state, out, read, ph);
+  // temporary buffer for contiguous storage of `key || len(id)`
+  uint8_t msg[17]{};
+  std::memcpy(msg, key, 16);
+
+  absorb_any<mode_t::Keyed, R_Kin, AbsorbKey_Color>(state, msg, 17ul, ph);
+}
+
+// Given permutation state(s), just permuted ( i.e. after `up()`, with empty
+// output ), this routine encrypts/ decrypts ( based on template parameter's
+// truthness ) b_len (<= R_Kout) -bytes block, using key stream held in state,
+// and absorbs plain text back into it, same as `up()` -> XOR -> `down()` does,
+// while working on a word at a time.
+//
+// Each word of input is read before respective word of output is written, so
+// `in` and `out` are allowed to be same buffer. When N > 1, it works on j -th of
+// N lane-transposed permutation states; see `cyclist_batch.hpp`.
+template<const bool decrypt, const size_t N = 1ul>
+static inline void
+crypt_block(uint32_t* const __restrict state,
+            const uint8_t* const in,
+            uint8_t* const out,
+            const size_t b_len,
+            const size_t j = 0ul)
+{
+  const size_t rm_bytes = b_len & 3ul;
+  const size_t till = b_len - rm_bytes;
+
+  size_t off = 0ul;
+  size_t idx = 0ul;
+  while (off < till) {
+    const uint32_t t = xoodyak_utils::from_le_bytes(in + off);
+    const uint32_t o = state[idx * N + j] ^ t;
 
-  for (size_t i = 0; i < read; i++) {
-    out[i] ^= in[i];
+    xoodyak_utils::to_le_bytes(o, out + off);
+    state[idx * N + j] ^= decrypt ? o : t;
+
+    off += 4ul;
+    idx += 1ul;
   }
 
-  if constexpr (decrypt) {
-    // force compile-time branch evaluation
-    static_assert(decrypt, "Must be decrypting !");
-    down<mode_t::Keyed, Zero_Color>(state, out, read, ph);
-  } else {
-    // force compile-time branch evaluation
-    static_assert(!decrypt, "Must be encrypting !");
-    down<mode_t::Keyed, Zero_Color>(state, in, read, ph);
+  uint32_t t = 0u;
+  if (rm_bytes > 0) {
+    std::memcpy(&t, in + off, rm_bytes);
   }
 
-  size_t boff = read;
-  while (boff < io_len) {
-    const size_t read = std::min(R_Kout, io_len - boff);
-    up<mode_t::Keyed, Zero_Color>(state, out + boff, read, ph);
+  if constexpr (std::endian::native == std::endian::big) {
+    t = xoodyak_utils::bswap32(t);
+  }
 
-    for (size_t i = 0; i < read; i++) {
-      out[boff + i] ^= in[boff + i];
+  const uint32_t mask = (1u << (rm_bytes * 8)) - 1u;
+  const uint32_t o = (state[idx * N + j] ^ t) & mask;
+
+  if (rm_bytes > 0) {
+    uint8_t o_[4];
+    xoodyak_utils::to_le_bytes(o, o_);
+    std::memcpy(out + off, o_, rm_bytes);
+  }
+
+  state[idx * N + j] ^= (decrypt ? o : t) ^ (0x01u << (rm_bytes * 8));
+}
+
+// Full block variant of `crypt_block()`, where block length ( = R_Kout ) is
+// known at compile-time, so that whole lanes are processed in a fully unrolled
+// loop. Same as `crypt_block()`, `in` and `out` are allowed to be same buffer.
+template<const bool decrypt, const size_t N = 1ul>
+static inline void
+crypt_block_full(uint32_t* const __restrict state,
+                 const uint8_t* const in,
+                 uint8_t* const out,
+                 const size_t j = 0ul)
+{
+  constexpr size_t words = R_Kout >> 2;
+
+#if defined __clang__
+#pragma clang loop unroll(enable)
+#elif defined __GNUG__
+#pragma GCC unroll 6
+#endif
+  for (size_t i = 0; i < words; i++) {
+    const uint32_t t = xoodyak_utils::from_le_bytes(in + (i << 2));
+    const uint32_t o = state[i * N + j] ^ t;
+
+    xoodyak_utils::to_le_bytes(o, out + (i << 2));
+    state[i * N + j] ^= decrypt ? o : t;
+  }
+
+  state[words * N + j] ^= 0x01u;
+}
+
+// Decrypts N -bytes cipher text, same as `crypt_any<true>()` does, while each
+// block of plain text goes to a scratch block, instead of caller's buffer, so
+// that state absorbs plain text, without it being released anywhere.
+static inline void
+crypt_discard(uint32_t* const __restrict state,       // 384 -bit state
+              const uint8_t* const __restrict cipher, // N -bytes cipher text
+              const size_t ct_len,                    // len(cipher) == N
+              phase_t* const __restrict ph            // phase of cyclist mode
+)
+{
+  // sized as whole permutation state, though at max R_Kout -bytes are written
+  uint8_t blk[48];
+
+  size_t boff = 0ul;
+  do {
+    const size_t read = std::min(R_Kout, ct_len - boff);
+
+    if (boff == 0ul) {
+      up<mode_t::Keyed, Crypt_Color>(state, nullptr, 0ul, ph);
+    } else {
+      up<mode_t::Keyed, Zero_Color>(state, nullptr, 0ul, ph);
     }
 
-    if constexpr (decrypt) {
-      // force compile-time branch evaluation
-      static_assert(decrypt, "Must be decrypting !");
-      down<mode_t::Keyed, Zero_Color>(state, out + boff, read, ph);
+    if (read == R_Kout) {
+      crypt_block_full<true>(state, cipher + boff, blk);
     } else {
-      // force compile-time branch evaluation
-      static_assert(!decrypt, "Must be encrypting !");
-      down<mode_t::Keyed, Zero_Color>(state, in + boff, read, ph);
+      crypt_block<true>(state, cipher + boff, blk, read);
     }
+    ph[0] = phase_t::Down;
 
     boff += read;
+  } while (boff < ct_len);
+}
+
+// Internal function used in Cyclist mode of operation, which encrypts/ decrypts
+// ( based on template parameter's truthness ) N -bytes input message, where
+// full blocks take lane-wide fast path & only the tail block ( if any ) takes
+// generic path.
+//
+// Input and output are allowed to be same buffer.
+template<const bool decrypt>
+static inline void
+crypt_any(uint32_t* const __restrict state, // 384 -bit permutation state
+          const uint8_t* const in,          // N -bytes input message
+          uint8_t* const out,               // N -bytes output message
+          const size_t io_len,              // len(in) == len(out) == N
+          phase_t* const __restrict ph      // phase of cyclist mode
+)
+{
+  // # -of full blocks, taking lane-wide path, is computed upfront, so that
+  // when `io_len` is known to be shorter than `R_Kout` ( say after inlining ),
+  // compiler sees that full block path is never taken
+  const size_t full = io_len / R_Kout;
+  const size_t tail = io_len - full * R_Kout;
+
+  for (size_t i = 0; i < full; i++) {
+    const size_t boff = i * R_Kout;
+
+    if (i == 0ul) {
+      up<mode_t::Keyed, Crypt_Color>(state, nullptr, 0ul, ph);
+    } else {
+      up<mode_t::Keyed, Zero_Color>(state, nullptr, 0ul, ph);
+    }
+
+    crypt_block_full<decrypt>(state, in + boff, out + boff);
+    ph[0] = phase_t::Down;
+  }
+
+  // tail block ( empty, when input is empty )
+  if ((tail > 0ul) || (full == 0ul)) {
+    const size_t boff = full * R_Kout;
+
+    if (full == 0ul) {
+      up<mode_t::Keyed, Crypt_Color>(state, nullptr, 0ul, ph);
+    } else {
+      up<mode_t::Keyed, Zero_Color>(state, nullptr, 0ul, ph);
+    }
+
+    crypt_block<decrypt>(state, in + boff, out + boff, tail);
+    ph[0] = phase_t::Down;
   }
 }
 
+// Internal function used in Cyclist mode of operation, which encrypts plain
+// text/ decrypts cipher text ( based on template parameter's truthness )
+//
+// See algorithmic definition in algorithm 3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const bool decrypt>
+static inline void
+crypt(uint32_t* const __restrict state,   // 384 -bit permutation state
+      const uint8_t* const __restrict in, // N -bytes input message
+      uint8_t* const __restrict out,      // N -bytes output message
+      const size_t io_len,                // len(in) == len(out) == N | N >= 0
+      phase_t* const __restrict ph        // phase of cyclist mode of operation
+)
+{
+  crypt_any<decrypt>(state, in, out, io_len, ph);
+}
+
+// Internal function used in Cyclist mode of operation, which encrypts plain
+// text/ decrypts cipher text ( based on template parameter's truthness ) in
+// place i.e. N -bytes buffer is overwritten with its encrypted/ decrypted form.
+//
+// Produces exactly same output as `crypt(...)` does, for same input.
+template<const bool decrypt>
+static inline void
+crypt_inplace(uint32_t* const __restrict state, // 384 -bit permutation state
+              uint8_t* const __restrict buf,    // N -bytes input/ output
+              const size_t io_len,              // len(buf) = N | N >= 0
+              phase_t* const __restrict ph      // phase of cyclist mode
+)
+{
+  crypt_any<decrypt>(state, buf, buf, io_len, ph);
+}
+
 // External function used in Cyclist mode of operation, which consumes N -bytes
 // input string, by absorbing those many bytes into permutation state
 //
@@ -351,6 +596,44 @@ squeeze(uint32_t* const __restrict state,
   }
 }
 
+// Squeezes N -bytes out of permutation state, same as `squeeze(...)` does, while
+// comparing them ( in constant-time ) against expected ones, a block at a time,
+// so that squeezed bytes are never materialized as a whole. Returns truth value
+// only when they match.
+template<const mode_t m>
+static inline bool
+squeeze_verify(uint32_t* const __restrict state,       // 384 -bit state
+               const uint8_t* const __restrict expect, // N (>0) -bytes
+               const size_t e_len,                     // len(expect)
+               phase_t* const __restrict ph            // phase of cyclist mode
+)
+{
+  constexpr size_t rate = m == mode_t::Hash ? R_Hash : R_Kout;
+
+  uint8_t blk[rate];
+  uint8_t f = 0;
+
+  size_t off = 0ul;
+  do {
+    // whole block is always extracted, only first `read` -bytes are compared
+    const size_t read = std::min(rate, e_len - off);
+    if (off == 0ul) {
+      up<m, Squeeze_Color>(state, blk, rate, ph);
+    } else {
+      down<m, Zero_Color>(state, nullptr, 0ul, ph);
+      up<m, Zero_Color>(state, blk, rate, ph);
+    }
+
+    for (size_t i = 0; i < read; i++) {
+      f |= expect[off + i] ^ blk[i];
+    }
+
+    off += read;
+  } while (off < e_len);
+
+  return f == 0;
+}
+
 // External function used in Cyclist mode of operation, which encrypts N -bytes
 // plain text input message
 //
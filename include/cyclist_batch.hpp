@@ -0,0 +1,276 @@
+#pragma once
+#include "cyclist.hpp"
+#include "xoodoo_batch.hpp"
+
+// Cyclist mode of operation, driving N independent instances at once, on top
+// of multi-state Xoodoo permutation. All N instances consume/ produce equal
+// length inputs/ outputs, so they go through exactly same sequence of `up()`/
+// `down()` calls, only working on different data.
+//
+// Permutation state is kept lane-transposed i.e. lane `i` of instance `j`
+// lives at index `i * N + j`; see `xoodoo_batch.hpp`.
+namespace cyclist {
+
+// Given lane-transposed permutation states of N instances, this routine
+// consumes b_len (<= rate) -bytes block into permutation state of j -th
+// instance, appending padding byte and domain seperator color, same as `down()`
+// does, for single instance
+template<const size_t N>
+static inline void
+down_lane(uint32_t* const __restrict state,
+          const size_t j,
+          const uint8_t* const __restrict blk,
+          const size_t b_len,
+          const uint8_t color)
+{
+  const size_t rm_bytes = b_len & 3ul;
+  const size_t till = b_len - rm_bytes;
+
+  size_t off = 0ul;
+  size_t idx = 0ul;
+  while (off < till) {
+    state[idx * N + j] ^= xoodyak_utils::from_le_bytes(blk + off);
+
+    off += 4ul;
+    idx += 1ul;
+  }
+
+  uint32_t lane = 0u;
+  if (rm_bytes > 0) {
+    std::memcpy(&lane, blk + off, rm_bytes);
+  }
+
+  if constexpr (std::endian::native == std::endian::big) {
+    lane = xoodyak_utils::bswap32(lane);
+  }
+
+  lane |= 0x01u << (rm_bytes * 8);
+  state[idx * N + j] ^= lane;
+  state[11 * N + j] ^= static_cast<uint32_t>(color) << 24;
+}
+
+// Given lane-transposed permutation states of N instances, this routine writes
+// first b_len (<= 48) -bytes of permutation state of j -th instance, to output
+template<const size_t N>
+static inline void
+extract_lane(const uint32_t* const __restrict state,
+             const size_t j,
+             uint8_t* const __restrict out,
+             const size_t b_len)
+{
+  for (size_t i = 0; i < b_len; i++) {
+    const uint32_t lane = state[(i >> 2) * N + j];
+    out[i] = static_cast<uint8_t>(lane >> ((i & 3ul) << 3));
+  }
+}
+
+// Given lane-transposed permutation states of N instances, just permuted, this
+// routine encrypts/ decrypts ( based on template parameter's truthness ) b_len
+// (<= R_Kout) -bytes block, using key stream squeezed out of j -th instance,
+// and absorbs plain text back into it, same as `up()` -> XOR -> `down()` does,
+// for single instance, while working on a word at a time
+template<const size_t N, const bool decrypt>
+static inline void
+crypt_lane(uint32_t* const __restrict state,
+           const size_t j,
+           const uint8_t* const __restrict in,
+           uint8_t* const __restrict out,
+           const size_t b_len)
+{
+  if (b_len == R_Kout) {
+    crypt_block_full<decrypt, N>(state, in, out, j);
+  } else {
+    crypt_block<decrypt, N>(state, in, out, b_len, j);
+  }
+}
+
+// Internal function used in Cyclist mode of operation, which consumes b_len
+// -bytes from each of N blocks ( starting at offset `b_off` ), into respective
+// permutation state
+//
+// See algorithmic definition in algorithm 3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t N, const mode_t m, const uint8_t color>
+static inline void
+down_xN(uint32_t* const __restrict state,
+        const uint8_t* const* const __restrict blk,
+        const size_t b_off,
+        const size_t b_len,
+        phase_t* const __restrict ph)
+{
+  for (size_t j = 0; j < N; j++) {
+    const uint8_t* const blk_ = b_len > 0 ? blk[j] + b_off : nullptr;
+    down_lane<N>(state, j, blk_, b_len, color);
+  }
+
+  ph[0] = phase_t::Down;
+}
+
+// Internal function used in Cyclist mode of operation, which permutes N states
+// at once and produces b_len -bytes output from each of them, written to
+// respective output block, starting at offset `b_off`
+//
+// See algorithmic definition in algorithm 3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t N, const mode_t m, const uint8_t color>
+static inline void
+up_xN(uint32_t* const __restrict state,
+      uint8_t* const* const __restrict blk,
+      const size_t b_off,
+      const size_t b_len,
+      phase_t* const __restrict ph)
+{
+  if constexpr (m == mode_t::Keyed) {
+    for (size_t j = 0; j < N; j++) {
+      state[11 * N + j] ^= static_cast<uint32_t>(color) << 24;
+    }
+  }
+
+  xoodoo::permute_batch<N>(state);
+
+  if (b_len > 0) {
+    for (size_t j = 0; j < N; j++) {
+      extract_lane<N>(state, j, blk[j] + b_off, b_len);
+    }
+  }
+
+  ph[0] = phase_t::Up;
+}
+
+// Internal function used in Cyclist mode of operation, which absorbs m_len
+// -many bytes from each of N messages into respective permutation state
+//
+// See algorithmic definition in algorithm 3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t N, const mode_t m, const size_t rate, const uint8_t color>
+static inline void
+absorb_any_xN(uint32_t* const __restrict state,
+              const uint8_t* const* const __restrict msg,
+              const size_t m_len,
+              phase_t* const __restrict ph)
+{
+  if (ph[0] != phase_t::Up) {
+    up_xN<N, m, Zero_Color>(state, nullptr, 0ul, 0ul, ph);
+  }
+
+  const size_t read = std::min(rate, m_len);
+  down_xN<N, m, color>(state, msg, 0ul, read, ph);
+
+  size_t boff = read;
+  while (boff < m_len) {
+    up_xN<N, m, Zero_Color>(state, nullptr, 0ul, 0ul, ph);
+
+    const size_t read = std::min(rate, m_len - boff);
+    down_xN<N, m, Zero_Color>(state, msg, boff, read, ph);
+
+    boff += read;
+  }
+}
+
+// Internal function used in Cyclist mode of operation, which squeezes o_len
+// -bytes out of each of N permutation states
+//
+// See algorithmic definition in algorithm 3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t N, const mode_t m, const size_t rate, const uint8_t color>
+static inline void
+squeeze_any_xN(uint32_t* const __restrict state,
+               uint8_t* const* const __restrict out,
+               const size_t o_len,
+               phase_t* const __restrict ph)
+{
+  const size_t upto = std::min(o_len, rate);
+  up_xN<N, m, color>(state, out, 0ul, upto, ph);
+
+  size_t l = upto;
+  while (l < o_len) {
+    down_xN<N, m, Zero_Color>(state, nullptr, 0ul, 0ul, ph);
+
+    const size_t tmp = std::min(o_len - l, rate);
+    up_xN<N, m, Zero_Color>(state, out, l, tmp, ph);
+    l += tmp;
+  }
+}
+
+// Internal function used in Cyclist mode of operation, which absorbs 128 -bit
+// secret key & 128 -bit public message nonce into each of N permutation states
+//
+// See algorithmic definition in algorithm 3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t N>
+static inline void
+absorb_key_xN(uint32_t* const __restrict state,
+              const uint8_t* const* const __restrict key,
+              const uint8_t* const* const __restrict nonce,
+              phase_t* const __restrict ph)
+{
+  // temporary buffers for contiguous storage of `key || nonce || len(nonce)`
+  uint8_t msg[N][33];
+  const uint8_t* msg_[N];
+
+  for (size_t j = 0; j < N; j++) {
+    std::memcpy(msg[j], key[j], 16);
+    std::memcpy(msg[j] + 16, nonce[j], 16);
+    msg[j][32] = static_cast<uint8_t>(16);
+
+    msg_[j] = msg[j];
+  }
+
+  absorb_any_xN<N, mode_t::Keyed, R_Kin, AbsorbKey_Color>(state, msg_, 33, ph);
+}
+
+// Internal function used in Cyclist mode of operation, which absorbs 128 -bit
+// secret key, with empty identifier, into each of N permutation states; see
+// single state `absorb_key(state, key, ph)`
+template<const size_t N>
+static inline void
+absorb_key_xN(uint32_t* const __restrict state,
+              const uint8_t* const* const __restrict key,
+              phase_t* const __restrict ph)
+{
+  // temporary buffers for contiguous storage of `key || len(id)`
+  uint8_t msg[N][17]{};
+  const uint8_t* msg_[N];
+
+  for (size_t j = 0; j < N; j++) {
+    std::memcpy(msg[j], key[j], 16);
+    msg_[j] = msg[j];
+  }
+
+  absorb_any_xN<N, mode_t::Keyed, R_Kin, AbsorbKey_Color>(state, msg_, 17, ph);
+}
+
+// Internal function used in Cyclist mode of operation, which encrypts/ decrypts
+// ( based on template parameter's truthness ) io_len -bytes of each of N input
+// messages
+//
+// See algorithmic definition in algorithm 3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t N, const bool decrypt>
+static inline void
+crypt_xN(uint32_t* const __restrict state,
+         const uint8_t* const* const __restrict in,
+         uint8_t* const* const __restrict out,
+         const size_t io_len,
+         phase_t* const __restrict ph)
+{
+  size_t boff = 0ul;
+  do {
+    const size_t read = std::min(R_Kout, io_len - boff);
+
+    if (boff == 0ul) {
+      up_xN<N, mode_t::Keyed, Crypt_Color>(state, nullptr, 0ul, 0ul, ph);
+    } else {
+      up_xN<N, mode_t::Keyed, Zero_Color>(state, nullptr, 0ul, 0ul, ph);
+    }
+
+    for (size_t j = 0; j < N; j++) {
+      crypt_lane<N, decrypt>(state, j, in[j] + boff, out[j] + boff, read);
+    }
+    ph[0] = phase_t::Down;
+
+    boff += read;
+  } while (boff < io_len);
+}
+
+}
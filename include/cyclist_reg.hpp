@@ -0,0 +1,896 @@
+#pragma once
+#include "cyclist.hpp"
+
+// Register-resident Cyclist mode of operation, where 384 -bit permutation state
+// is kept in three 128 -bit registers ( one per plane ), for whole message, so
+// that absorb, crypt and squeeze loops never spill it to memory, between two
+// consecutive permutation calls. State is loaded/ stored only at API
+// boundaries.
+//
+// Engine routines are templated over instruction set extension & forcefully
+// inlined into ISA specific entry points ( see `XOODOO_TARGET` ), which are
+// flattened ( see `XOODOO_FLATTEN` ), so that Xoodoo rounds get inlined into
+// message processing loops.
+//
+// Lanes are interpreted as little endian words, so it's x86 only.
+namespace cyclist::reg {
+
+#if defined XOODOO_X86
+
+// see `xoodoo.hpp`, for why `-Wignored-attributes` is silenced
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+
+using xoodoo::isa_t;
+using state_t = std::array<__m128i, 3>;
+
+#define XOODOO_ALWAYS_INLINE                                                   \
+  XOODOO_TARGET("sse2") __attribute__((always_inline)) inline
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on
+// register-resident state, using round function of requested instruction set
+// extension ( AVX2 has none of its own, for single state, so it uses SSSE3
+// one ), unrolled at compile-time, using template recursion.
+//
+// Note, `xoodoo::*::apply_rounds` can't be used here, because it's forcefully
+// inlined, while this routine is compiled for SSE2, before being inlined into
+// ISA specific entry point.
+template<const isa_t isa, const size_t r_idx = 0>
+XOODOO_ALWAYS_INLINE state_t
+permute(const state_t s)
+{
+  if constexpr (r_idx == xoodoo::ROUNDS) {
+    return s;
+  } else if constexpr (isa == isa_t::avx512) {
+    return permute<isa, r_idx + 1>(xoodoo::avx512::round<r_idx>(s));
+  } else if constexpr (isa == isa_t::ssse3) {
+    return permute<isa, r_idx + 1>(xoodoo::ssse3::round<r_idx>(s));
+  } else {
+    static_assert(isa == isa_t::sse2, "Must be one of SSE2/ SSSE3/ AVX512");
+    return permute<isa, r_idx + 1>(xoodoo::sse2::round<r_idx>(s));
+  }
+}
+
+// XORs domain seperator color into last byte of permutation state
+XOODOO_ALWAYS_INLINE state_t
+add_color(state_t s, const uint8_t color)
+{
+  const auto c = _mm_setr_epi32(0, 0, 0, static_cast<int>(color) << 24);
+  s[2] = _mm_xor_si128(s[2], c);
+
+  return s;
+}
+
+// Same as `down()`, consuming b_len (< 48) -bytes block ( of any length ),
+// after appending padding byte to it
+XOODOO_ALWAYS_INLINE state_t
+down(state_t s,
+     const uint8_t* const blk,
+     const size_t b_len,
+     const uint8_t color)
+{
+  alignas(16) uint8_t tmp[48]{};
+  if (b_len > 0) {
+    std::memcpy(tmp, blk, b_len);
+  }
+
+  tmp[b_len] = 0x01;
+  tmp[47] ^= color;
+
+  for (size_t i = 0; i < 3; i++) {
+    const auto t = _mm_load_si128(reinterpret_cast<const __m128i*>(tmp) + i);
+    s[i] = _mm_xor_si128(s[i], t);
+  }
+
+  return s;
+}
+
+// Full block variant of `down()`, where block length is rate of Cyclist mode (
+// i.e. one of 16, 24, 44 ), so that it's directly loaded into registers
+template<const size_t rate>
+XOODOO_ALWAYS_INLINE state_t
+down_full(state_t s, const uint8_t* const blk, const uint8_t color)
+{
+  const auto c = static_cast<int>(color) << 24;
+
+  if constexpr (rate == R_Hash) {
+    const auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blk));
+
+    s[0] = _mm_xor_si128(s[0], b0);
+    s[1] = _mm_xor_si128(s[1], _mm_setr_epi32(1, 0, 0, 0));
+    s[2] = _mm_xor_si128(s[2], _mm_setr_epi32(0, 0, 0, c));
+  } else if constexpr (rate == R_Kout) {
+    const auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blk));
+    const auto b1 =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(blk + 16));
+
+    s[0] = _mm_xor_si128(s[0], b0);
+    s[1] = _mm_xor_si128(s[1], _mm_xor_si128(b1, _mm_setr_epi32(0, 0, 1, 0)));
+    s[2] = _mm_xor_si128(s[2], _mm_setr_epi32(0, 0, 0, c));
+  } else {
+    static_assert(rate == R_Kin, "Must be one of R_Hash/ R_Kout/ R_Kin");
+
+    const auto b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blk));
+    const auto b1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(blk + 16));
+    const auto b2 = _mm_unpacklo_epi64(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(blk + 32)),
+      _mm_setr_epi32(
+        static_cast<int>(xoodyak_utils::from_le_bytes(blk + 40)), 1 | c, 0, 0));
+
+    s[0] = _mm_xor_si128(s[0], b0);
+    s[1] = _mm_xor_si128(s[1], b1);
+    s[2] = _mm_xor_si128(s[2], b2);
+  }
+
+  return s;
+}
+
+// Writes first b_len (<= 48) -bytes of permutation state to output
+XOODOO_ALWAYS_INLINE void
+extract(const state_t s, uint8_t* const out, const size_t b_len)
+{
+  alignas(16) uint8_t tmp[48];
+
+  for (size_t i = 0; i < 3; i++) {
+    _mm_store_si128(reinterpret_cast<__m128i*>(tmp) + i, s[i]);
+  }
+
+  if (b_len > 0) {
+    std::memcpy(out, tmp, b_len);
+  }
+}
+
+// Absorbs N -bytes message into permutation state, same as `absorb_any()`,
+// when called while phase of Cyclist mode is `Down` ( i.e. `up()` required
+// before first block ) or `Up`, denoted by `up_first`
+template<const isa_t isa, const mode_t m, const size_t rate>
+XOODOO_ALWAYS_INLINE state_t
+absorb_any(state_t s,
+           const uint8_t* const msg,
+           const size_t m_len,
+           const uint8_t color,
+           const bool up_first)
+{
+  if (up_first) {
+    s = permute<isa>(s);
+  }
+
+  size_t boff = 0ul;
+  do {
+    const size_t read = std::min(rate, m_len - boff);
+    const uint8_t c = boff == 0ul ? color : Zero_Color;
+
+    if (boff > 0ul) {
+      s = permute<isa>(s);
+    }
+
+    if (read == rate) {
+      s = down_full<rate>(s, msg + boff, c);
+    } else {
+      s = down(s, msg + boff, read, c);
+    }
+
+    boff += read;
+  } while (boff < m_len);
+
+  return s;
+}
+
+// Squeezes N -bytes output out of permutation state, same as `squeeze_any()`
+template<const isa_t isa, const mode_t m, const size_t rate>
+XOODOO_ALWAYS_INLINE state_t
+squeeze_any(state_t s, uint8_t* const out, const size_t o_len)
+{
+  if constexpr (m == mode_t::Keyed) {
+    s = add_color(s, Squeeze_Color);
+  }
+
+  size_t l = 0ul;
+  do {
+    if (l > 0ul) {
+      // `down()` with empty block, appends padding byte only
+      s[0] = _mm_xor_si128(s[0], _mm_setr_epi32(1, 0, 0, 0));
+    }
+
+    s = permute<isa>(s);
+
+    const size_t read = std::min(rate, o_len - l);
+    if (read == R_Hash) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + l), s[0]);
+    } else {
+      extract(s, out + l, read);
+    }
+
+    l += read;
+  } while (l < o_len);
+
+  return s;
+}
+
+// Encrypts/ decrypts ( based on template parameter's truthness ) N -bytes
+// input, same as `crypt()`, where full blocks are XORed with key stream, held
+// in registers, while plain text blocks are absorbed back into them.
+//
+// Input is always read before output is written, so `in` and `out` are
+// allowed to be same buffer. When `store` is false, output is never written (
+// `out` can be nullptr ), only state is updated, as if it were.
+template<const isa_t isa, const bool decrypt, const bool store = true>
+XOODOO_ALWAYS_INLINE state_t
+crypt(state_t s,
+      const uint8_t* const in,
+      uint8_t* const out,
+      const size_t io_len)
+{
+  size_t boff = 0ul;
+  do {
+    const size_t read = std::min(R_Kout, io_len - boff);
+
+    s = add_color(s, boff == 0ul ? Crypt_Color : Zero_Color);
+    s = permute<isa>(s);
+
+    if (read == R_Kout) {
+      const auto i0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + boff));
+      const auto i1 =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + boff + 16));
+
+      const auto o0 = _mm_xor_si128(s[0], i0);
+      const auto o1 = _mm_move_epi64(_mm_xor_si128(s[1], i1));
+
+      if constexpr (store) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + boff), o0);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + boff + 16), o1);
+      }
+
+      const auto p0 = decrypt ? o0 : i0;
+      const auto p1 = decrypt ? o1 : i1;
+
+      s[0] = _mm_xor_si128(s[0], p0);
+      s[1] = _mm_xor_si128(s[1], _mm_xor_si128(p1, _mm_setr_epi32(0, 0, 1, 0)));
+    } else {
+      alignas(16) uint8_t ks[48];
+      alignas(16) uint8_t blk[48]{};
+
+      extract(s, ks, R_Kout);
+
+      for (size_t i = 0; i < read; i++) {
+        const uint8_t t = in[boff + i];
+        const uint8_t o = t ^ ks[i];
+
+        if constexpr (store) {
+          out[boff + i] = o;
+        }
+        blk[i] = decrypt ? o : t;
+      }
+      blk[read] = 0x01;
+
+      for (size_t i = 0; i < 3; i++) {
+        const auto t =
+          _mm_load_si128(reinterpret_cast<const __m128i*>(blk) + i);
+        s[i] = _mm_xor_si128(s[i], t);
+      }
+    }
+
+    boff += read;
+  } while (boff < io_len);
+
+  return s;
+}
+
+// Xoodyak hash, computing 32 -bytes digest of N -bytes message, with
+// permutation state kept in registers, from beginning to end
+template<const isa_t isa>
+XOODOO_ALWAYS_INLINE void
+hash(const uint8_t* const msg, const size_t m_len, uint8_t* const out)
+{
+  state_t s{ _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+  s = absorb_any<isa, mode_t::Hash, R_Hash>(
+    s, msg, m_len, Absorb_Color_Hash, false);
+  s = squeeze_any<isa, mode_t::Hash, R_Hash>(s, out, 32);
+}
+
+// Xoodyak AEAD, encrypting/ decrypting ( based on template parameter's
+// truthness ) M -bytes input, after absorbing N -bytes associated data, under
+// given key & nonce, while computing 16 -bytes authentication tag, with
+// permutation state kept in registers, from beginning to end
+template<const isa_t isa, const bool decrypt>
+XOODOO_ALWAYS_INLINE void
+aead(const uint8_t* const key,
+     const uint8_t* const nonce,
+     const uint8_t* const data,
+     const size_t dt_len,
+     const uint8_t* const in,
+     uint8_t* const out,
+     const size_t io_len,
+     uint8_t* const tag)
+{
+  uint8_t kn[33];
+  std::memcpy(kn, key, 16);
+  std::memcpy(kn + 16, nonce, 16);
+  kn[32] = static_cast<uint8_t>(16);
+
+  state_t s{ _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+  s = down(s, kn, sizeof(kn), AbsorbKey_Color);
+  s = absorb_any<isa, mode_t::Keyed, R_Kin>(
+    s, data, dt_len, Absorb_Color_Keyed, true);
+  s = crypt<isa, decrypt>(s, in, out, io_len);
+  s = squeeze_any<isa, mode_t::Keyed, R_Kout>(s, tag, 16);
+}
+
+// Same as `aead()`, but starting from keyed permutation state snapshot, which
+// holds `key || 0^16 || len(nonce)`, already absorbed ( see `key_schedule.hpp`
+// ), so that only 16 -bytes nonce is XORed into it, while loading it into
+// registers, instead of absorbing key again
+template<const isa_t isa, const bool decrypt>
+XOODOO_ALWAYS_INLINE void
+aead_keyed(const uint32_t* const snapshot,
+           const uint8_t* const nonce,
+           const uint8_t* const data,
+           const size_t dt_len,
+           const uint8_t* const in,
+           uint8_t* const out,
+           const size_t io_len,
+           uint8_t* const tag)
+{
+  state_t s;
+  for (size_t i = 0; i < 3; i++) {
+    s[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(snapshot) + i);
+  }
+
+  const auto n = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nonce));
+  s[1] = _mm_xor_si128(s[1], n);
+
+  s = absorb_any<isa, mode_t::Keyed, R_Kin>(
+    s, data, dt_len, Absorb_Color_Keyed, true);
+  s = crypt<isa, decrypt>(s, in, out, io_len);
+  s = squeeze_any<isa, mode_t::Keyed, R_Kout>(s, tag, 16);
+}
+
+// Xoodyak MAC, computing N -bytes authentication tag of M -bytes message, under
+// given key ( absorbed with empty identifier ), with permutation state kept in
+// registers, from beginning to end
+template<const isa_t isa>
+XOODOO_ALWAYS_INLINE void
+mac(const uint8_t* const key,
+    const uint8_t* const msg,
+    const size_t m_len,
+    uint8_t* const tag,
+    const size_t t_len)
+{
+  uint8_t k[17]{};
+  std::memcpy(k, key, 16);
+
+  state_t s{ _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+  s = down(s, k, sizeof(k), AbsorbKey_Color);
+  s = absorb_any<isa, mode_t::Keyed, R_Kin>(
+    s, msg, m_len, Absorb_Color_Keyed, true);
+  s = squeeze_any<isa, mode_t::Keyed, R_Kout>(s, tag, t_len);
+}
+
+// Single frame of Cyclist session mode i.e. `Absorb(data) -> Crypt(in) ->
+// Squeeze(16)`, continuing from ( and leaving behind ) permutation state held
+// in memory, which is loaded into registers only once per frame. `up_first`
+// denotes whether phase of Cyclist mode is `Down`, before absorbing data.
+template<const isa_t isa, const bool decrypt>
+XOODOO_ALWAYS_INLINE void
+frame(uint32_t* const state,
+      const bool up_first,
+      const uint8_t* const data,
+      const size_t dt_len,
+      const uint8_t* const in,
+      uint8_t* const out,
+      const size_t io_len,
+      uint8_t* const tag)
+{
+  state_t s;
+  for (size_t i = 0; i < 3; i++) {
+    s[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state) + i);
+  }
+
+  s = absorb_any<isa, mode_t::Keyed, R_Kin>(
+    s, data, dt_len, Absorb_Color_Keyed, up_first);
+  s = crypt<isa, decrypt>(s, in, out, io_len);
+  s = squeeze_any<isa, mode_t::Keyed, R_Kout>(s, tag, 16);
+
+  for (size_t i = 0; i < 3; i++) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state) + i, s[i]);
+  }
+}
+
+// Xoodyak verified decryption, which first computes 16 -bytes authentication
+// tag of M -bytes cipher text ( after absorbing N -bytes associated data ),
+// without writing any plain text out, and only when it matches expected tag,
+// decrypts cipher text again, from register-resident snapshot of state, taken
+// before first pass. Returns truth value only when tags match.
+template<const isa_t isa>
+XOODOO_ALWAYS_INLINE bool
+aead_verify(const uint8_t* const key,
+            const uint8_t* const nonce,
+            const uint8_t* const tag,
+            const uint8_t* const data,
+            const size_t dt_len,
+            const uint8_t* const cipher,
+            uint8_t* const text,
+            const size_t ct_len)
+{
+  uint8_t kn[33];
+  std::memcpy(kn, key, 16);
+  std::memcpy(kn + 16, nonce, 16);
+  kn[32] = static_cast<uint8_t>(16);
+
+  state_t s{ _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+  s = down(s, kn, sizeof(kn), AbsorbKey_Color);
+  s = absorb_any<isa, mode_t::Keyed, R_Kin>(
+    s, data, dt_len, Absorb_Color_Keyed, true);
+
+  const state_t s0 = s;
+
+  uint8_t tag_[16];
+  s = crypt<isa, true, false>(s, cipher, nullptr, ct_len);
+  s = squeeze_any<isa, mode_t::Keyed, R_Kout>(s, tag_, sizeof(tag_));
+
+  uint8_t f = 0;
+  for (size_t i = 0; i < sizeof(tag_); i++) {
+    f |= tag[i] ^ tag_[i];
+  }
+
+  if (f == 0) {
+    crypt<isa, true>(s0, cipher, text, ct_len);
+  }
+
+  return f == 0;
+}
+
+// ISA specific entry points, into which whole engine gets inlined
+
+XOODOO_TARGET("sse2")
+XOODOO_FLATTEN
+static inline void
+hash_sse2(const uint8_t* const msg, const size_t m_len, uint8_t* const out)
+{
+  hash<isa_t::sse2>(msg, m_len, out);
+}
+
+XOODOO_TARGET("ssse3")
+XOODOO_FLATTEN
+static inline void
+hash_ssse3(const uint8_t* const msg, const size_t m_len, uint8_t* const out)
+{
+  hash<isa_t::ssse3>(msg, m_len, out);
+}
+
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
+static inline void
+hash_avx512(const uint8_t* const msg, const size_t m_len, uint8_t* const out)
+{
+  hash<isa_t::avx512>(msg, m_len, out);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("sse2")
+XOODOO_FLATTEN
+static inline void
+aead_sse2(const uint8_t* const key,
+          const uint8_t* const nonce,
+          const uint8_t* const data,
+          const size_t dt_len,
+          const uint8_t* const in,
+          uint8_t* const out,
+          const size_t io_len,
+          uint8_t* const tag)
+{
+  aead<isa_t::sse2, decrypt>(key, nonce, data, dt_len, in, out, io_len, tag);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("ssse3")
+XOODOO_FLATTEN
+static inline void
+aead_ssse3(const uint8_t* const key,
+           const uint8_t* const nonce,
+           const uint8_t* const data,
+           const size_t dt_len,
+           const uint8_t* const in,
+           uint8_t* const out,
+           const size_t io_len,
+           uint8_t* const tag)
+{
+  aead<isa_t::ssse3, decrypt>(key, nonce, data, dt_len, in, out, io_len, tag);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
+static inline void
+aead_avx512(const uint8_t* const key,
+            const uint8_t* const nonce,
+            const uint8_t* const data,
+            const size_t dt_len,
+            const uint8_t* const in,
+            uint8_t* const out,
+            const size_t io_len,
+            uint8_t* const tag)
+{
+  aead<isa_t::avx512, decrypt>(key, nonce, data, dt_len, in, out, io_len, tag);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("sse2")
+XOODOO_FLATTEN
+static inline void
+aead_keyed_sse2(const uint32_t* const snapshot,
+                const uint8_t* const nonce,
+                const uint8_t* const data,
+                const size_t dt_len,
+                const uint8_t* const in,
+                uint8_t* const out,
+                const size_t io_len,
+                uint8_t* const tag)
+{
+  aead_keyed<isa_t::sse2, decrypt>(
+    snapshot, nonce, data, dt_len, in, out, io_len, tag);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("ssse3")
+XOODOO_FLATTEN
+static inline void
+aead_keyed_ssse3(const uint32_t* const snapshot,
+                 const uint8_t* const nonce,
+                 const uint8_t* const data,
+                 const size_t dt_len,
+                 const uint8_t* const in,
+                 uint8_t* const out,
+                 const size_t io_len,
+                 uint8_t* const tag)
+{
+  aead_keyed<isa_t::ssse3, decrypt>(
+    snapshot, nonce, data, dt_len, in, out, io_len, tag);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
+static inline void
+aead_keyed_avx512(const uint32_t* const snapshot,
+                  const uint8_t* const nonce,
+                  const uint8_t* const data,
+                  const size_t dt_len,
+                  const uint8_t* const in,
+                  uint8_t* const out,
+                  const size_t io_len,
+                  uint8_t* const tag)
+{
+  aead_keyed<isa_t::avx512, decrypt>(
+    snapshot, nonce, data, dt_len, in, out, io_len, tag);
+}
+
+XOODOO_TARGET("sse2")
+XOODOO_FLATTEN
+static inline void
+mac_sse2(const uint8_t* const key,
+         const uint8_t* const msg,
+         const size_t m_len,
+         uint8_t* const tag,
+         const size_t t_len)
+{
+  mac<isa_t::sse2>(key, msg, m_len, tag, t_len);
+}
+
+XOODOO_TARGET("ssse3")
+XOODOO_FLATTEN
+static inline void
+mac_ssse3(const uint8_t* const key,
+          const uint8_t* const msg,
+          const size_t m_len,
+          uint8_t* const tag,
+          const size_t t_len)
+{
+  mac<isa_t::ssse3>(key, msg, m_len, tag, t_len);
+}
+
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
+static inline void
+mac_avx512(const uint8_t* const key,
+           const uint8_t* const msg,
+           const size_t m_len,
+           uint8_t* const tag,
+           const size_t t_len)
+{
+  mac<isa_t::avx512>(key, msg, m_len, tag, t_len);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("sse2")
+XOODOO_FLATTEN
+static inline void
+frame_sse2(uint32_t* const state,
+           const bool up_first,
+           const uint8_t* const data,
+           const size_t dt_len,
+           const uint8_t* const in,
+           uint8_t* const out,
+           const size_t io_len,
+           uint8_t* const tag)
+{
+  frame<isa_t::sse2, decrypt>(
+    state, up_first, data, dt_len, in, out, io_len, tag);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("ssse3")
+XOODOO_FLATTEN
+static inline void
+frame_ssse3(uint32_t* const state,
+            const bool up_first,
+            const uint8_t* const data,
+            const size_t dt_len,
+            const uint8_t* const in,
+            uint8_t* const out,
+            const size_t io_len,
+            uint8_t* const tag)
+{
+  frame<isa_t::ssse3, decrypt>(
+    state, up_first, data, dt_len, in, out, io_len, tag);
+}
+
+template<const bool decrypt>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
+static inline void
+frame_avx512(uint32_t* const state,
+             const bool up_first,
+             const uint8_t* const data,
+             const size_t dt_len,
+             const uint8_t* const in,
+             uint8_t* const out,
+             const size_t io_len,
+             uint8_t* const tag)
+{
+  frame<isa_t::avx512, decrypt>(
+    state, up_first, data, dt_len, in, out, io_len, tag);
+}
+
+XOODOO_TARGET("sse2")
+XOODOO_FLATTEN
+static inline bool
+aead_verify_sse2(const uint8_t* const key,
+                 const uint8_t* const nonce,
+                 const uint8_t* const tag,
+                 const uint8_t* const data,
+                 const size_t dt_len,
+                 const uint8_t* const cipher,
+                 uint8_t* const text,
+                 const size_t ct_len)
+{
+  return aead_verify<isa_t::sse2>(
+    key, nonce, tag, data, dt_len, cipher, text, ct_len);
+}
+
+XOODOO_TARGET("ssse3")
+XOODOO_FLATTEN
+static inline bool
+aead_verify_ssse3(const uint8_t* const key,
+                  const uint8_t* const nonce,
+                  const uint8_t* const tag,
+                  const uint8_t* const data,
+                  const size_t dt_len,
+                  const uint8_t* const cipher,
+                  uint8_t* const text,
+                  const size_t ct_len)
+{
+  return aead_verify<isa_t::ssse3>(
+    key, nonce, tag, data, dt_len, cipher, text, ct_len);
+}
+
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
+static inline bool
+aead_verify_avx512(const uint8_t* const key,
+                   const uint8_t* const nonce,
+                   const uint8_t* const tag,
+                   const uint8_t* const data,
+                   const size_t dt_len,
+                   const uint8_t* const cipher,
+                   uint8_t* const text,
+                   const size_t ct_len)
+{
+  return aead_verify<isa_t::avx512>(
+    key, nonce, tag, data, dt_len, cipher, text, ct_len);
+}
+
+#undef XOODOO_ALWAYS_INLINE
+
+#pragma GCC diagnostic pop
+
+#endif
+
+using hash_fn_t = void (*)(const uint8_t*, size_t, uint8_t*);
+using aead_fn_t = void (*)(const uint8_t*,
+                           const uint8_t*,
+                           const uint8_t*,
+                           size_t,
+                           const uint8_t*,
+                           uint8_t*,
+                           size_t,
+                           uint8_t*);
+using keyed_aead_fn_t = void (*)(const uint32_t*,
+                                 const uint8_t*,
+                                 const uint8_t*,
+                                 size_t,
+                                 const uint8_t*,
+                                 uint8_t*,
+                                 size_t,
+                                 uint8_t*);
+using mac_fn_t =
+  void (*)(const uint8_t*, const uint8_t*, size_t, uint8_t*, size_t);
+using verify_fn_t = bool (*)(const uint8_t*,
+                             const uint8_t*,
+                             const uint8_t*,
+                             const uint8_t*,
+                             size_t,
+                             const uint8_t*,
+                             uint8_t*,
+                             size_t);
+using frame_fn_t = void (*)(uint32_t*,
+                            bool,
+                            const uint8_t*,
+                            size_t,
+                            const uint8_t*,
+                            uint8_t*,
+                            size_t,
+                            uint8_t*);
+
+// Returns register-resident hash routine, for requested instruction set
+// extension, if there's one, otherwise returns nullptr.
+static inline hash_fn_t
+hash_kernel(const xoodoo::isa_t isa)
+{
+#if defined XOODOO_X86
+  switch (isa) {
+    case isa_t::avx512:
+      return hash_avx512;
+    case isa_t::avx2:
+    case isa_t::ssse3:
+      return hash_ssse3;
+    case isa_t::sse2:
+      return hash_sse2;
+    default:
+      break;
+  }
+#endif
+
+  (void)isa;
+  return nullptr;
+}
+
+// Returns register-resident AEAD routine ( encrypting/ decrypting, based on
+// template parameter's truthness ), for requested instruction set extension, if
+// there's one, otherwise returns nullptr.
+template<const bool decrypt>
+static inline aead_fn_t
+aead_kernel(const xoodoo::isa_t isa)
+{
+#if defined XOODOO_X86
+  switch (isa) {
+    case isa_t::avx512:
+      return aead_avx512<decrypt>;
+    case isa_t::avx2:
+    case isa_t::ssse3:
+      return aead_ssse3<decrypt>;
+    case isa_t::sse2:
+      return aead_sse2<decrypt>;
+    default:
+      break;
+  }
+#endif
+
+  (void)isa;
+  return nullptr;
+}
+
+// Returns register-resident AEAD routine ( encrypting/ decrypting, based on
+// template parameter's truthness ), which starts from keyed permutation state
+// snapshot, for requested instruction set extension, if there's one, otherwise
+// returns nullptr.
+template<const bool decrypt>
+static inline keyed_aead_fn_t
+aead_keyed_kernel(const xoodoo::isa_t isa)
+{
+#if defined XOODOO_X86
+  switch (isa) {
+    case isa_t::avx512:
+      return aead_keyed_avx512<decrypt>;
+    case isa_t::avx2:
+    case isa_t::ssse3:
+      return aead_keyed_ssse3<decrypt>;
+    case isa_t::sse2:
+      return aead_keyed_sse2<decrypt>;
+    default:
+      break;
+  }
+#endif
+
+  (void)isa;
+  return nullptr;
+}
+
+// Returns register-resident MAC routine, for requested instruction set
+// extension, if there's one, otherwise returns nullptr.
+static inline mac_fn_t
+mac_kernel(const xoodoo::isa_t isa)
+{
+#if defined XOODOO_X86
+  switch (isa) {
+    case isa_t::avx512:
+      return mac_avx512;
+    case isa_t::avx2:
+    case isa_t::ssse3:
+      return mac_ssse3;
+    case isa_t::sse2:
+      return mac_sse2;
+    default:
+      break;
+  }
+#endif
+
+  (void)isa;
+  return nullptr;
+}
+
+// Returns register-resident session mode frame routine ( encrypting/
+// decrypting, based on template parameter's truthness ), for requested
+// instruction set extension, if there's one, otherwise returns nullptr.
+template<const bool decrypt>
+static inline frame_fn_t
+frame_kernel(const xoodoo::isa_t isa)
+{
+#if defined XOODOO_X86
+  switch (isa) {
+    case isa_t::avx512:
+      return frame_avx512<decrypt>;
+    case isa_t::avx2:
+    case isa_t::ssse3:
+      return frame_ssse3<decrypt>;
+    case isa_t::sse2:
+      return frame_sse2<decrypt>;
+    default:
+      break;
+  }
+#endif
+
+  (void)isa;
+  return nullptr;
+}
+
+// Returns register-resident verify-before-decrypt routine, for requested
+// instruction set extension, if there's one, otherwise returns nullptr.
+static inline verify_fn_t
+aead_verify_kernel(const xoodoo::isa_t isa)
+{
+#if defined XOODOO_X86
+  switch (isa) {
+    case isa_t::avx512:
+      return aead_verify_avx512;
+    case isa_t::avx2:
+    case isa_t::ssse3:
+      return aead_verify_ssse3;
+    case isa_t::sse2:
+      return aead_verify_sse2;
+    default:
+      break;
+  }
+#endif
+
+  (void)isa;
+  return nullptr;
+}
+
+}
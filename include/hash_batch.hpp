@@ -0,0 +1,210 @@
+#pragma once
+#include "cyclist_batch.hpp"
+#include "xoodyak.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+namespace batch {
+
+// Leftover messages ( i.e. not part of a run of equal length ones ) are hashed
+// one at a time, when there are fewer than these many of them, as interleaving
+// them across lanes wouldn't pay off
+constexpr size_t HASH_MIN_LANES = 4ul;
+
+// Hashes messages order[from..to), which are all of same length, N at a time,
+// using multi-state Xoodoo permutation, returning index of first message, not
+// yet hashed ( i.e. fewer than N of them remain )
+template<const size_t N>
+static inline size_t
+hash_run(const uint8_t* const* const __restrict msg,
+         const size_t m_len,
+         uint8_t* const* const __restrict out,
+         const size_t* const __restrict order,
+         size_t from,
+         const size_t to)
+{
+  while (from + N <= to) {
+    const uint8_t* msg_[N];
+    uint8_t* out_[N];
+
+    for (size_t j = 0; j < N; j++) {
+      msg_[j] = msg[order[from + j]];
+      out_[j] = out[order[from + j]];
+    }
+
+    hash_xN<N>(msg_, m_len, out_);
+    from += N;
+  }
+
+  return from;
+}
+
+// Message, currently being hashed by a SIMD lane & where it's at
+struct hash_lane_t
+{
+  size_t desc = 0ul; // index of message
+  size_t step = 0ul; // # -of permutations, lane went through, for message
+  size_t blks = 0ul; // # -of message blocks
+  bool active = false;
+};
+
+// Hashes messages order[0..cnt), of different lengths, by keeping N of them in
+// flight, in lane-transposed permutation states, where each lane takes next
+// message, as soon as it's done with current one, same as `crypt_batch(...)`
+// does for AEAD. Messages are expected in longest-first order, so that lanes
+// stay busy till the end.
+//
+// Each message goes through `Absorb(msg) -> Squeeze(32)` of hash mode, i.e.
+// one permutation per 16 -bytes block, followed by two more for squeezing.
+template<const size_t N>
+static inline void
+hash_lanes(const uint8_t* const* const __restrict msg,
+           const size_t* const __restrict m_len,
+           uint8_t* const* const __restrict out,
+           const size_t* const __restrict order,
+           const size_t cnt)
+{
+  constexpr size_t rate = cyclist::R_Hash;
+
+  alignas(64) uint32_t state[12 * N]{};
+  hash_lane_t lanes[N]{};
+  size_t next = 0ul;
+  size_t active = 0ul;
+
+  // assign next message ( if any ) to j -th lane & absorb its first block
+  auto refill = [&](const size_t j) {
+    if (next == cnt) {
+      lanes[j].active = false;
+      return;
+    }
+
+    const size_t i = order[next++];
+
+    lanes[j].desc = i;
+    lanes[j].step = 0ul;
+    lanes[j].blks = std::max<size_t>(1, (m_len[i] + rate - 1) / rate);
+    lanes[j].active = true;
+
+    for (size_t k = 0; k < 12; k++) {
+      state[k * N + j] = 0u;
+    }
+
+    const size_t len = std::min(rate, m_len[i]);
+    cyclist::down_lane<N>(state, j, msg[i], len, cyclist::Absorb_Color_Hash);
+  };
+
+  for (size_t j = 0; j < N; j++) {
+    refill(j);
+    active += lanes[j].active;
+  }
+
+  while (active > 0) {
+    xoodoo::permute_batch<N>(state);
+
+    for (size_t j = 0; j < N; j++) {
+      hash_lane_t& l = lanes[j];
+      if (!l.active) {
+        continue;
+      }
+
+      const size_t i = l.desc;
+      l.step++;
+
+      if (l.step < l.blks) {
+        // absorb next message block
+        const size_t off = l.step * rate;
+        const size_t len = std::min(rate, m_len[i] - off);
+
+        cyclist::down_lane<N>(state, j, msg[i] + off, len, cyclist::Zero_Color);
+      } else if (l.step == l.blks) {
+        // squeeze first half of digest
+        cyclist::extract_lane<N>(state, j, out[i], rate);
+        cyclist::down_lane<N>(state, j, nullptr, 0ul, cyclist::Zero_Color);
+      } else {
+        // squeeze second half of digest
+        cyclist::extract_lane<N>(state, j, out[i] + rate, rate);
+
+        refill(j);
+        active -= !lanes[j].active;
+      }
+    }
+  }
+}
+
+// Hashes messages order[from..to), which are in ascending order of length,
+// where each run of at least N equal length messages is hashed N at a time,
+// using `hash_xN(...)`, while leftovers of all runs are hashed together, using
+// `hash_lanes(...)`, when there are enough of them to fill lanes, otherwise one
+// at a time
+template<const size_t N>
+static inline void
+hash_sorted(const uint8_t* const* const __restrict msg,
+            const size_t* const __restrict m_len,
+            uint8_t* const* const __restrict out,
+            const size_t* const __restrict order,
+            const size_t from,
+            const size_t to)
+{
+  std::vector<size_t> rest;
+
+  size_t i = from;
+  while (i < to) {
+    const size_t len = m_len[order[i]];
+
+    size_t end = i + 1;
+    while ((end < to) && (m_len[order[end]] == len)) {
+      end++;
+    }
+
+    i = hash_run<N>(msg, len, out, order, i, end);
+    rest.insert(rest.end(), order + i, order + end);
+    i = end;
+  }
+
+  if (rest.size() < HASH_MIN_LANES) {
+    for (const size_t k : rest) {
+      hash(msg[k], m_len[k], out[k]);
+    }
+    return;
+  }
+
+  std::reverse(rest.begin(), rest.end());
+  hash_lanes<N>(msg, m_len, out, rest.data(), rest.size());
+}
+
+}
+
+// Xoodyak cryptographic hash function, computing digests of n independent
+// messages ( of any length ) in a single call. Messages are ordered by length,
+// so that each run of equal length messages is hashed 16 ( with AVX-512 ) or 8
+// at a time, using multi-state Xoodoo permutation, while leftovers of all runs
+// are interleaved across SIMD lanes, each lane taking next message as soon as
+// it's done with current one.
+//
+// Produces exactly same digests as n independent calls to `hash(...)`
+static inline void
+hash_batch(const uint8_t* const* const __restrict msg, // n messages
+           const size_t* const __restrict m_len,       // len(msg[i])
+           uint8_t* const* const __restrict out,       // n 32 -bytes digests
+           const size_t n                              // # -of messages
+)
+{
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0ul);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return m_len[a] < m_len[b];
+  });
+
+  if (xoodoo::active_isa() >= xoodoo::isa_t::avx512) {
+    batch::hash_sorted<16>(msg, m_len, out, order.data(), 0, n);
+  } else {
+    batch::hash_sorted<8>(msg, m_len, out, order.data(), 0, n);
+  }
+}
+
+}
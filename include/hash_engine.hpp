@@ -0,0 +1,254 @@
+#pragma once
+#include "hash_batch.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Messages longer than these many bytes are hashed on their own, using single
+// permutation state, by `hash_engine_t`, while shorter ones are grouped with
+// similarly sized ones, to be hashed together, using multi-state permutation
+constexpr size_t ENGINE_LARGE_LEN = 16384ul;
+
+// Groups of short messages, handed out by `hash_engine_t`, hold ( roughly )
+// these many bytes
+constexpr size_t ENGINE_GROUP_LEN = 65536ul;
+
+namespace engine {
+
+// Unit of work, i.e. messages order[from..to), hashed together
+struct task_t
+{
+  size_t from;
+  size_t to;
+};
+
+// Double ended queue of tasks, owned by a worker, which takes tasks from its
+// front, while other workers steal from its back, once they run out of their
+// own tasks
+struct queue_t
+{
+  std::mutex lock;
+  std::deque<task_t> tasks;
+
+  inline bool pop(task_t* const t)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (tasks.empty()) {
+      return false;
+    }
+
+    *t = tasks.front();
+    tasks.pop_front();
+    return true;
+  }
+
+  inline bool steal(task_t* const t)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (tasks.empty()) {
+      return false;
+    }
+
+    *t = tasks.back();
+    tasks.pop_back();
+    return true;
+  }
+};
+
+}
+
+// Xoodyak parallel batch hashing engine, which owns a fixed pool of worker
+// threads ( created once, reused across batches ), for computing digests of
+// large number of independent messages of widely varying lengths.
+//
+// Messages of a batch are ordered by length ( longest first ) and cut into
+// tasks, where each message longer than `ENGINE_LARGE_LEN` forms its own task,
+// while shorter ones are grouped with similarly sized neighbours, into tasks of
+// ~`ENGINE_GROUP_LEN` -bytes, which are hashed together, using multi-state
+// Xoodoo permutation ( see `hash_batch(...)` ). Tasks are dealt out to per
+// worker queues, largest ones first, so that each worker starts with a huge
+// message ( if any ) and once a worker drains its own queue, it steals from
+// back of other workers' queues, keeping all of them busy, till the very end.
+//
+// Produces exactly same digests as n independent calls to `hash(...)`, no
+// matter how many worker threads are used.
+struct hash_engine_t
+{
+private:
+  std::vector<std::thread> workers;
+  std::vector<engine::queue_t> queues;
+
+  // serializes concurrent calls to `hash(...)`
+  std::mutex submit;
+
+  // batch being hashed & how workers are signalled about it
+  std::mutex lock;
+  std::condition_variable start_cv, done_cv;
+  size_t generation = 0ul;
+  size_t busy = 0ul;
+  bool stop = false;
+
+  const uint8_t* const* b_msg = nullptr;
+  const size_t* b_len = nullptr;
+  uint8_t* const* b_out = nullptr;
+  std::vector<size_t> order;
+
+  // Hashes messages of a single task, either on their own or together
+  inline void run(const engine::task_t t)
+  {
+    if (t.to - t.from == 1ul) {
+      const size_t i = order[t.from];
+      xoodyak::hash(b_msg[i], b_len[i], b_out[i]);
+      return;
+    }
+
+    // task holds messages in longest-first order, while `hash_sorted(...)`
+    // expects them in ascending order
+    std::reverse(order.begin() + t.from, order.begin() + t.to);
+
+    if (xoodoo::active_isa() >= xoodoo::isa_t::avx512) {
+      batch::hash_sorted<16>(b_msg, b_len, b_out, order.data(), t.from, t.to);
+    } else {
+      batch::hash_sorted<8>(b_msg, b_len, b_out, order.data(), t.from, t.to);
+    }
+  }
+
+  // Body of w -th worker thread, which waits for a batch, drains its own queue,
+  // steals from others, till all of them are empty, and then waits for next
+  // batch
+  inline void work(const size_t w)
+  {
+    size_t seen = 0ul;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        start_cv.wait(guard, [&]() { return stop || (generation != seen); });
+
+        if (stop) {
+          return;
+        }
+        seen = generation;
+      }
+
+      const size_t n = queues.size();
+      engine::task_t t;
+
+      while (true) {
+        bool found = queues[w].pop(&t);
+        for (size_t k = 1; !found && (k < n); k++) {
+          found = queues[(w + k) % n].steal(&t);
+        }
+
+        if (!found) {
+          break;
+        }
+
+        run(t);
+      }
+
+      std::lock_guard<std::mutex> guard(lock);
+      if (--busy == 0ul) {
+        done_cv.notify_one();
+      }
+    }
+  }
+
+public:
+  // Starts fixed pool of `n_threads` worker threads ( 0 denotes all available
+  // hardware threads )
+  inline explicit hash_engine_t(const size_t n_threads = 0ul)
+  {
+    size_t threads = n_threads;
+    if (threads == 0ul) {
+      threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    queues = std::vector<engine::queue_t>(threads);
+    workers.reserve(threads);
+
+    for (size_t w = 0; w < threads; w++) {
+      workers.emplace_back([this, w]() { work(w); });
+    }
+  }
+
+  inline ~hash_engine_t()
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stop = true;
+    }
+    start_cv.notify_all();
+
+    for (auto& t : workers) {
+      t.join();
+    }
+  }
+
+  hash_engine_t(const hash_engine_t&) = delete;
+  hash_engine_t& operator=(const hash_engine_t&) = delete;
+
+  // Returns # -of worker threads, in pool
+  inline size_t threads() const { return workers.size(); }
+
+  // Computes 32 -bytes digests of n independent messages, on worker threads,
+  // returning only when all of them are computed. Calling thread just waits,
+  // while workers hash.
+  inline void hash(const uint8_t* const* const __restrict msg, // n messages
+                   const size_t* const __restrict m_len,       // len(msg[i])
+                   uint8_t* const* const __restrict out, // n 32 -bytes digests
+                   const size_t n                        // # -of messages
+  )
+  {
+    if (n == 0ul) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> serial(submit);
+
+    b_msg = msg;
+    b_len = m_len;
+    b_out = out;
+
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0ul);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return m_len[a] > m_len[b];
+    });
+
+    // cut longest-first ordered messages into tasks & deal them out, round
+    // robin, so that each queue holds tasks in decreasing order of size
+    size_t q = 0ul;
+    size_t i = 0ul;
+    while (i < n) {
+      size_t end = i + 1;
+
+      if (m_len[order[i]] <= ENGINE_LARGE_LEN) {
+        size_t bytes = m_len[order[i]] + 1;
+        while ((end < n) && (bytes < ENGINE_GROUP_LEN)) {
+          bytes += m_len[order[end]] + 1;
+          end++;
+        }
+      }
+
+      queues[q].tasks.push_back({ i, end });
+      q = (q + 1) % queues.size();
+      i = end;
+    }
+
+    std::unique_lock<std::mutex> guard(lock);
+
+    busy = workers.size();
+    generation++;
+    start_cv.notify_all();
+
+    done_cv.wait(guard, [&]() { return busy == 0ul; });
+  }
+};
+
+}
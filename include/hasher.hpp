@@ -0,0 +1,64 @@
+#pragma once
+#include "xof.hpp"
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Incremental Xoodyak cryptographic hash function, which can consume message
+// arriving in arbitrary sized chunks, by calling `update(...)` as many times as
+// needed, before calling `finalize(...)` once, for producing 32 -bytes digest.
+//
+// Produces exactly same digest as `hash(...)` does, when called on all chunks,
+// concatenated, while it never holds more than `R_Hash` ( = 16 ) -bytes of
+// message internally.
+//
+// See section 1.3.1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+struct hasher_t
+{
+private:
+  xof_t xof;
+  bool finalized = false;
+
+public:
+  inline hasher_t() = default;
+
+  // Given N (>=0) -bytes message chunk, this routine absorbs all full message
+  // blocks into permutation state, while buffering remaining bytes, until next
+  // call to `update(...)` or `finalize(...)`.
+  //
+  // Once `finalize(...)` is called, calling this routine doesn't do anything.
+  inline void update(const uint8_t* const __restrict msg, const size_t m_len)
+  {
+    if (finalized) {
+      return;
+    }
+
+    xof.absorb(msg, m_len);
+  }
+
+  // Absorbs remaining buffered message bytes ( if any ) and squeezes 32 -bytes
+  // digest out of permutation state. Message must not be updated after this.
+  //
+  // Once called, calling it again doesn't do anything.
+  inline void finalize(uint8_t* const __restrict out)
+  {
+    if (finalized) {
+      return;
+    }
+
+    xof.squeeze(out, DIGEST_LEN);
+    finalized = true;
+  }
+
+  // Resets hasher to its initial state, so that it can be used for hashing
+  // another message.
+  inline void reset()
+  {
+    xof.reset();
+    finalized = false;
+  }
+};
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "xoodyak.hpp"
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Xoodyak key schedule, which absorbs 16 -bytes secret key into permutation
+// state once, keeping a snapshot of resulting 48 -bytes state, so that each
+// message encrypted/ decrypted under that key starts from the snapshot and only
+// absorbs 16 -bytes public message nonce.
+//
+// Note, Xoodyak absorbs `key || nonce || len(nonce)` as a single block, which
+// doesn't involve any permutation call, so the snapshot can't be taken after a
+// permutation. Instead it holds `key || 0^16 || len(nonce)`, already padded and
+// domain separated, as `absorb_key(...)` would leave it, while nonce is XORed
+// into state lanes [4, 8) per message. Resulting states are bit-by-bit same as
+// the ones obtained by calling `absorb_key(...)`, as `down(...)` is linear.
+// Where available, messages are encrypted/ decrypted by register-resident
+// Cyclist engine ( see `cyclist_reg.hpp` ), which loads snapshot and nonce
+// straight into registers.
+//
+// See section 1.3.2 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+struct key_schedule_t
+{
+private:
+  alignas(16) uint32_t snapshot[12]{};
+
+public:
+  // Absorbs 16 -bytes secret key ( along with all zero nonce ) into permutation
+  // state and keeps it as snapshot
+  inline key_schedule_t(const uint8_t* const __restrict key)
+  {
+    constexpr uint8_t zeros[16]{};
+    cyclist::phase_t ph = cyclist::phase_t::Up;
+
+    cyclist::absorb_key(snapshot, key, zeros, &ph);
+  }
+
+  // Restores keyed permutation state from snapshot and absorbs 16 -bytes public
+  // message nonce into it, leaving state exactly as `absorb_key(...)` does
+  inline void absorb_nonce(uint32_t* const __restrict state,
+                           const uint8_t* const __restrict nonce,
+                           cyclist::phase_t* const __restrict ph) const
+  {
+    std::memcpy(state, snapshot, sizeof(snapshot));
+
+    for (size_t i = 0; i < 4; i++) {
+      state[4 + i] ^= xoodyak_utils::from_le_bytes(nonce + i * 4);
+    }
+
+    ph[0] = cyclist::phase_t::Down;
+  }
+
+  // Xoodyak Authenticated Encryption with Associated Data routine, which given
+  // 16 -bytes public message nonce, N -bytes associated data & M -bytes plain
+  // text, computes M -bytes encrypted text & 16 -bytes authentication tag,
+  // under the key this schedule is built from.
+  //
+  // Produces exactly same cipher text and tag as `xoodyak::encrypt(...)` does.
+  inline void encrypt(
+    const uint8_t* const __restrict nonce, // 128 -bit public message nonce
+    const uint8_t* const __restrict data,  // N (>= 0) -bytes associated data
+    const size_t dt_len,                   // len(data)
+    const uint8_t* const __restrict text,  // M (>= 0) -bytes plain text
+    uint8_t* const __restrict cipher,      // M (>= 0) -bytes cipher text
+    const size_t ct_len,                   // len(text) == len(cipher)
+    uint8_t* const __restrict tag          // 128 -bit authentication tag
+  ) const
+  {
+    static const auto fn =
+      cyclist::reg::aead_keyed_kernel<false>(xoodoo::active_isa());
+    if (fn != nullptr) {
+      fn(snapshot, nonce, data, dt_len, text, cipher, ct_len, tag);
+    } else {
+      cyclist::phase_t ph = cyclist::phase_t::Up;
+      alignas(16) uint32_t state[12];
+
+      absorb_nonce(state, nonce, &ph);
+      cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
+      cyclist::encrypt(state, text, cipher, ct_len, &ph);
+      cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag, 16ul, &ph);
+    }
+  }
+
+  // Xoodyak Verified Decryption with Associated Data routine, which given 16
+  // -bytes public message nonce, 16 -bytes authentication tag, N -bytes
+  // associated data & M -bytes cipher text, computes M -bytes deciphered text
+  // along with boolean flag denoting verification status, under the key this
+  // schedule is built from.
+  //
+  // Produces exactly same plain text and flag as `xoodyak::decrypt(...)` does.
+  inline bool decrypt(
+    const uint8_t* const __restrict nonce,  // 128 -bit public message nonce
+    const uint8_t* const __restrict tag,    // 128 -bit authentication tag
+    const uint8_t* const __restrict data,   // N (>= 0) -bytes associated data
+    const size_t dt_len,                    // len(data)
+    const uint8_t* const __restrict cipher, // M (>= 0) -bytes cipher text
+    uint8_t* const __restrict text,         // M (>= 0) -bytes plain text
+    const size_t ct_len                     // len(cipher) == len(text)
+  ) const
+  {
+    uint8_t tag_[16]{};
+
+    static const auto fn =
+      cyclist::reg::aead_keyed_kernel<true>(xoodoo::active_isa());
+    if (fn != nullptr) {
+      fn(snapshot, nonce, data, dt_len, cipher, text, ct_len, tag_);
+    } else {
+      cyclist::phase_t ph = cyclist::phase_t::Up;
+      alignas(16) uint32_t state[12];
+
+      absorb_nonce(state, nonce, &ph);
+      cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
+      cyclist::decrypt(state, cipher, text, ct_len, &ph);
+      cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag_, 16ul, &ph);
+    }
+
+    bool f = false;
+    for (size_t i = 0; i < 16; i++) {
+      f |= static_cast<bool>(tag[i] ^ tag_[i]);
+    }
+
+    // don't release unverified plain text !
+    std::memset(text, 0, f * ct_len);
+    return !f;
+  }
+};
+
+}
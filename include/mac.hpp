@@ -0,0 +1,423 @@
+#pragma once
+#include "xoodyak.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Tags of at most these many bytes are verified by `mac_verify(...)`, after
+// computing them into stack buffer, using register-resident engine
+constexpr size_t MAC_MAX_FAST_TAG_LEN = 64ul;
+
+// Xoodyak message authentication code ( read MAC ) context, which can consume
+// message arriving in arbitrary sized chunks, by calling `update(...)` as many
+// times as needed, before calling `finalize(...)` ( or `verify(...)` ) once,
+// for producing ( or checking ) authentication tag of caller chosen length.
+//
+// Tag is computed as `Cyclist(K, ε, ε) -> Absorb(msg) -> Squeeze(ℓ)` of keyed
+// mode, so unlike tag computed by `encrypt(...)`, on empty plain text, there's
+// neither nonce nor `Crypt()` call.
+//
+// Produces exactly same tag as `mac(...)` does, when called on all chunks,
+// concatenated, while it never holds more than `R_Kin` ( = 44 ) -bytes of
+// message internally.
+//
+// See section 1.2 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+struct mac_t
+{
+private:
+  alignas(16) uint32_t state[12]{};
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+
+  // partially filled message block, waiting for more bytes
+  uint8_t buf[cyclist::R_Kin]{};
+  size_t buf_len = 0ul;
+
+  // how many message blocks are already absorbed into permutation state
+  size_t blk_cnt = 0ul;
+  bool finalized = false;
+
+  // Absorbs single message block ( of length <= `R_Kin` ) into permutation
+  // state, following `absorb_any(...)` routine of Cyclist mode of operation,
+  // where only the first block is absorbed with domain seperator color
+  inline void absorb_block(const uint8_t* const blk, const size_t b_len)
+  {
+    using cyclist::mode_t;
+
+    cyclist::up<mode_t::Keyed, cyclist::Zero_Color>(state, nullptr, 0ul, &ph);
+
+    if (blk_cnt == 0ul) {
+      cyclist::down<mode_t::Keyed, cyclist::Absorb_Color_Keyed>(
+        state, blk, b_len, &ph);
+    } else {
+      cyclist::down<mode_t::Keyed, cyclist::Zero_Color>(state, blk, b_len, &ph);
+    }
+
+    blk_cnt++;
+  }
+
+  // Absorbs remaining buffered message bytes ( or empty block, when message is
+  // empty ), so that tag can be squeezed
+  inline void finish()
+  {
+    if ((buf_len > 0ul) || (blk_cnt == 0ul)) {
+      absorb_block(buf, buf_len);
+      buf_len = 0ul;
+    }
+
+    finalized = true;
+  }
+
+public:
+  // Absorbs 16 -bytes secret key into permutation state, so that context is
+  // ready for consuming message
+  inline explicit mac_t(const uint8_t* const __restrict key // 128 -bit key
+  )
+  {
+    cyclist::absorb_key(state, key, &ph);
+  }
+
+  // Given N (>=0) -bytes message chunk, this routine absorbs all full message
+  // blocks into permutation state, while buffering remaining bytes, until next
+  // call to `update(...)` or `finalize(...)`.
+  //
+  // Once tag is squeezed, calling this routine doesn't do anything.
+  inline void update(const uint8_t* const __restrict msg, const size_t m_len)
+  {
+    if (finalized) {
+      return;
+    }
+
+    constexpr size_t rate = cyclist::R_Kin;
+
+    size_t off = 0ul;
+    while (off < m_len) {
+      // full blocks are absorbed directly from input, without buffering
+      if ((buf_len == 0ul) && ((m_len - off) >= rate)) {
+        absorb_block(msg + off, rate);
+        off += rate;
+
+        continue;
+      }
+
+      const size_t read = std::min(rate - buf_len, m_len - off);
+      std::memcpy(buf + buf_len, msg + off, read);
+
+      buf_len += read;
+      off += read;
+
+      if (buf_len == rate) {
+        absorb_block(buf, rate);
+        buf_len = 0ul;
+      }
+    }
+  }
+
+  // Finishes message absorption and squeezes N (>0) -bytes authentication tag
+  // out of permutation state.
+  //
+  // Once called, calling it again doesn't do anything.
+  inline void finalize(uint8_t* const __restrict tag, const size_t t_len)
+  {
+    if (finalized) {
+      return;
+    }
+
+    finish();
+    cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag, t_len, &ph);
+  }
+
+  // Finishes message absorption and compares ( in constant-time ) squeezed N
+  // (>0) -bytes authentication tag against expected one, returning truth value
+  // only when they match.
+  //
+  // Once tag is squeezed, calling it again returns false.
+  inline bool verify(const uint8_t* const __restrict tag, const size_t t_len)
+  {
+    if (finalized || (t_len == 0ul)) {
+      return false;
+    }
+
+    finish();
+    return cyclist::squeeze_verify<cyclist::mode_t::Keyed>(
+      state, tag, t_len, &ph);
+  }
+};
+
+// Xoodyak message authentication code, which given 16 -bytes secret key and N
+// -bytes message, computes M -bytes authentication tag, where M is chosen by
+// caller ( 16 -bytes or more is recommended ), as `Cyclist(K, ε, ε) ->
+// Absorb(msg) -> Squeeze(M)` of keyed mode.
+//
+// When executing CPU supports SSE2 ( or better ), permutation state is kept in
+// registers, for whole message; see `cyclist_reg.hpp`.
+static inline void
+mac(const uint8_t* const __restrict key, // 128 -bit secret key
+    const uint8_t* const __restrict msg, // N (>=0) -bytes message
+    const size_t m_len,                  // len(msg)
+    uint8_t* const __restrict tag,       // M (>0) -bytes authentication tag
+    const size_t t_len                   // len(tag)
+)
+{
+  static const auto fn = cyclist::reg::mac_kernel(xoodoo::active_isa());
+  if (fn != nullptr) {
+    fn(key, msg, m_len, tag, t_len);
+    return;
+  }
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  cyclist::absorb_key(state, key, &ph);
+  cyclist::absorb<cyclist::mode_t::Keyed>(state, msg, m_len, &ph);
+  cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag, t_len, &ph);
+}
+
+// Xoodyak message authentication code verification, which computes M -bytes
+// tag of N -bytes message, same as `mac(...)` does, and compares it ( in
+// constant-time ) against expected one, returning truth value only when they
+// match.
+//
+// Tags of length <= `MAC_MAX_FAST_TAG_LEN` are computed using `mac(...)` into
+// stack buffer, longer ones are compared a block at a time.
+static inline bool
+mac_verify(const uint8_t* const __restrict key, // 128 -bit secret key
+           const uint8_t* const __restrict msg, // N (>=0) -bytes message
+           const size_t m_len,                  // len(msg)
+           const uint8_t* const __restrict tag, // M (>0) -bytes expected tag
+           const size_t t_len                   // len(tag)
+)
+{
+  if (t_len == 0ul) {
+    return false;
+  }
+
+  if (t_len <= MAC_MAX_FAST_TAG_LEN) {
+    uint8_t tag_[MAC_MAX_FAST_TAG_LEN];
+    mac(key, msg, m_len, tag_, t_len);
+
+    uint8_t f = 0;
+    for (size_t i = 0; i < t_len; i++) {
+      f |= tag[i] ^ tag_[i];
+    }
+
+    return f == 0;
+  }
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  cyclist::absorb_key(state, key, &ph);
+  cyclist::absorb<cyclist::mode_t::Keyed>(state, msg, m_len, &ph);
+  return cyclist::squeeze_verify<cyclist::mode_t::Keyed>(state, tag, t_len, &ph);
+}
+
+// Xoodyak message authentication code, computing M -bytes tags of N independent,
+// equal length messages at once ( each under its own key ), by keeping N
+// permutation states side by side and permuting them together, using
+// multi-state Xoodoo permutation.
+//
+// Produces exactly same tags as N independent calls to `mac(...)`
+template<const size_t N>
+static inline void
+mac_xN(const uint8_t* const* const __restrict key, // N 128 -bit keys
+       const uint8_t* const* const __restrict msg, // N messages
+       const size_t m_len,                         // len(msg[i])
+       uint8_t* const* const __restrict tag,       // N M -bytes tags
+       const size_t t_len                          // len(tag[i])
+)
+{
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(64) uint32_t state[12 * N]{};
+
+  cyclist::absorb_key_xN<N>(state, key, &ph);
+  cyclist::absorb_any_xN<N,
+                         cyclist::mode_t::Keyed,
+                         cyclist::R_Kin,
+                         cyclist::Absorb_Color_Keyed>(state, msg, m_len, &ph);
+  cyclist::squeeze_any_xN<N,
+                          cyclist::mode_t::Keyed,
+                          cyclist::R_Kout,
+                          cyclist::Squeeze_Color>(state, tag, t_len, &ph);
+}
+
+// Describes single message to be authenticated by `mac_batch(...)`. Different
+// messages can have different message and tag lengths.
+struct mac_desc_t
+{
+  const uint8_t* key; // 128 -bit secret key
+  const uint8_t* msg; // N (>= 0) -bytes message
+  size_t m_len;       // len(msg)
+  uint8_t* tag;       // M (> 0) -bytes authentication tag, computed
+  size_t t_len;       // len(tag)
+};
+
+namespace batch {
+
+// Number of message blocks, absorbed for a message; empty message is absorbed
+// as single empty block
+inline size_t
+msg_blocks(const mac_desc_t& d)
+{
+  constexpr size_t rate = cyclist::R_Kin;
+  return std::max<size_t>(1, (d.m_len + rate - 1) / rate);
+}
+
+// Number of tag blocks, squeezed for a message
+inline size_t
+tag_blocks(const mac_desc_t& d)
+{
+  constexpr size_t rate = cyclist::R_Kout;
+  return (d.t_len + rate - 1) / rate;
+}
+
+// Cyclist steps ( each one ending in a permutation call ), required for
+// authenticating a message, i.e. message blocks + tag blocks
+inline size_t
+step_count(const mac_desc_t& d)
+{
+  return msg_blocks(d) + tag_blocks(d);
+}
+
+// Message, currently being authenticated by a SIMD lane & where it's at
+struct mac_lane_t
+{
+  size_t desc = 0ul;     // index of message descriptor
+  size_t step = 0ul;     // next Cyclist step to be taken
+  size_t msg_blks = 0ul; // number of message blocks
+  size_t tag_blks = 0ul; // number of tag blocks
+  bool active = false;
+};
+
+// Given N lane-transposed permutation states, this routine computes tags of n
+// independent messages, of different lengths, by keeping N of them in flight,
+// following same lane refilling schedule as `crypt_batch(...)` does.
+template<const size_t N>
+static inline void
+mac_lanes(const mac_desc_t* const __restrict descs, const size_t n)
+{
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0ul);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return step_count(descs[a]) > step_count(descs[b]);
+  });
+
+  alignas(64) uint32_t state[12 * N]{};
+  mac_lane_t lanes[N]{};
+  size_t next = 0ul;
+  size_t active = 0ul;
+
+  // assign next message ( if any ) to j -th lane & absorb key ( with empty
+  // identifier ) into its permutation state, as `absorb_key()` does
+  auto refill = [&](const size_t j) {
+    // nothing to squeeze for zero -length tag
+    while ((next < n) && (descs[order[next]].t_len == 0ul)) {
+      next++;
+    }
+
+    if (next == n) {
+      lanes[j].active = false;
+      return;
+    }
+
+    const mac_desc_t& d = descs[order[next]];
+
+    lanes[j].desc = order[next];
+    lanes[j].step = 0ul;
+    lanes[j].msg_blks = msg_blocks(d);
+    lanes[j].tag_blks = tag_blocks(d);
+    lanes[j].active = true;
+
+    uint8_t blk[17];
+    std::memcpy(blk, d.key, 16);
+    blk[16] = 0;
+
+    for (size_t i = 0; i < 12; i++) {
+      state[i * N + j] = 0u;
+    }
+    cyclist::down_lane<N>(state, j, blk, 17, cyclist::AbsorbKey_Color);
+
+    next++;
+  };
+
+  for (size_t j = 0; j < N; j++) {
+    refill(j);
+    active += lanes[j].active;
+  }
+
+  while (active > 0) {
+    // color to be XORed into state, before permutation, as `up()` does
+    for (size_t j = 0; j < N; j++) {
+      const mac_lane_t& l = lanes[j];
+      if (!l.active || (l.step != l.msg_blks)) {
+        continue;
+      }
+
+      state[11 * N + j] ^= static_cast<uint32_t>(cyclist::Squeeze_Color) << 24;
+    }
+
+    xoodoo::permute_batch<N>(state);
+
+    for (size_t j = 0; j < N; j++) {
+      mac_lane_t& l = lanes[j];
+      if (!l.active) {
+        continue;
+      }
+
+      const mac_desc_t& d = descs[l.desc];
+
+      if (l.step < l.msg_blks) {
+        // absorb message block
+        const size_t off = l.step * cyclist::R_Kin;
+        const size_t len = std::min(cyclist::R_Kin, d.m_len - off);
+        const uint8_t color =
+          l.step == 0 ? cyclist::Absorb_Color_Keyed : cyclist::Zero_Color;
+
+        cyclist::down_lane<N>(state, j, d.msg + off, len, color);
+      } else {
+        // squeeze next block of authentication tag
+        const size_t off = (l.step - l.msg_blks) * cyclist::R_Kout;
+        const size_t len = std::min(cyclist::R_Kout, d.t_len - off);
+
+        cyclist::extract_lane<N>(state, j, d.tag + off, len);
+
+        if (l.step + 1 == l.msg_blks + l.tag_blks) {
+          refill(j);
+          active -= !lanes[j].active;
+          continue;
+        }
+
+        // more tag bytes to be squeezed, as `squeeze_any()` does
+        cyclist::down_lane<N>(state, j, nullptr, 0ul, cyclist::Zero_Color);
+      }
+
+      l.step++;
+    }
+  }
+}
+
+}
+
+// Xoodyak message authentication code, computing tags of n independent messages
+// ( each with its own key, message & tag length ) in a single call.
+//
+// Messages are interleaved across SIMD lanes of multi-state Xoodoo permutation
+// ( 16 lanes with AVX-512, otherwise 8 ), refilling a lane as soon as its
+// message is done, so unlike `mac_xN(...)`, messages need not be of same
+// length, nor their count be a multiple of lane count. Produces exactly same
+// tags as n independent calls to `mac(...)`.
+static inline void
+mac_batch(const mac_desc_t* const __restrict descs, const size_t n)
+{
+  if (xoodoo::active_isa() >= xoodoo::isa_t::avx512) {
+    batch::mac_lanes<16>(descs, n);
+  } else {
+    batch::mac_lanes<8>(descs, n);
+  }
+}
+
+}
@@ -0,0 +1,217 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Utility functions used in Xoodyak AEAD
+namespace xoodyak_utils {
+
+// A single `parallel_for(...)` call, posted to thread pool, which helper
+// threads join ( at max `wanted` of them ), claiming groups of items, till all
+// of them are claimed
+struct pool_job_t
+{
+  std::atomic<size_t> next{ 0ul };
+  size_t n_items = 0ul;
+  size_t group = 1ul;
+
+  // type erased `work(from, to)` callable
+  void (*run)(void*, size_t, size_t) = nullptr;
+  void* ctx = nullptr;
+
+  // guarded by pool's lock
+  size_t wanted = 0ul;
+  size_t active = 0ul;
+  std::condition_variable done;
+
+  // Keeps claiming next group of items & working on it, till none are left
+  inline void drain()
+  {
+    while (true) {
+      const size_t from = next.fetch_add(group, std::memory_order_relaxed);
+      if (from >= n_items) {
+        break;
+      }
+
+      run(ctx, from, std::min(from + group, n_items));
+    }
+  }
+};
+
+// Fixed pool of helper threads ( created once, reused across calls ), which
+// pick posted jobs, in order, helping thread posting a job to finish it.
+//
+// Thread posting a job always works on it too, so job completes even when all
+// helpers are busy with other jobs ( or when `parallel_for(...)` is called from
+// within work of another one ), while helpers only join a job till it's fully
+// claimed.
+struct thread_pool_t
+{
+private:
+  std::vector<std::thread> helpers;
+  std::deque<pool_job_t*> jobs;
+  std::mutex lock;
+  std::condition_variable job_cv;
+  bool stop = false;
+
+  // Body of helper thread, which waits for a job, joins it and helps till all
+  // of its items are claimed
+  inline void help()
+  {
+    while (true) {
+      pool_job_t* job = nullptr;
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        job_cv.wait(guard, [&]() { return stop || !jobs.empty(); });
+
+        if (stop) {
+          return;
+        }
+
+        job = jobs.front();
+        job->active++;
+        if (--job->wanted == 0ul) {
+          jobs.pop_front();
+        }
+      }
+
+      job->drain();
+
+      std::lock_guard<std::mutex> guard(lock);
+      if (--job->active == 0ul) {
+        job->done.notify_all();
+      }
+    }
+  }
+
+public:
+  // Starts `n_helpers` helper threads
+  inline explicit thread_pool_t(const size_t n_helpers)
+  {
+    helpers.reserve(n_helpers);
+    for (size_t i = 0; i < n_helpers; i++) {
+      helpers.emplace_back([this]() { help(); });
+    }
+  }
+
+  inline ~thread_pool_t()
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stop = true;
+    }
+    job_cv.notify_all();
+
+    for (auto& t : helpers) {
+      t.join();
+    }
+  }
+
+  thread_pool_t(const thread_pool_t&) = delete;
+  thread_pool_t& operator=(const thread_pool_t&) = delete;
+
+  // Returns # -of helper threads, in pool
+  inline size_t size() const { return helpers.size(); }
+
+  // Posts job, letting at max `n_helpers` helper threads join it, while calling
+  // thread works on it too, returning only when all of its items are processed
+  inline void run(pool_job_t& job, const size_t n_helpers)
+  {
+    if (n_helpers > 0ul) {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        job.wanted = n_helpers;
+        jobs.push_back(&job);
+      }
+
+      if (n_helpers == 1ul) {
+        job_cv.notify_one();
+      } else {
+        job_cv.notify_all();
+      }
+    }
+
+    job.drain();
+
+    if (n_helpers > 0ul) {
+      std::unique_lock<std::mutex> guard(lock);
+
+      // all items are claimed, so no more helpers should join
+      const auto it = std::find(jobs.begin(), jobs.end(), &job);
+      if (it != jobs.end()) {
+        jobs.erase(it);
+      }
+
+      job.done.wait(guard, [&]() { return job.active == 0ul; });
+    }
+  }
+};
+
+// Process wide thread pool, shared by all parallel routines, which is started
+// on first use, with one helper thread less than available hardware threads (
+// calling thread being the remaining one ).
+//
+// Note, it's `inline` but not `static`, so that there's a single pool, shared by
+// all translation units.
+inline thread_pool_t&
+shared_pool()
+{
+  static thread_pool_t pool(
+    std::max<size_t>(1, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+// Given n items, split into consecutive groups of ( at max ) `group` items,
+// this routine calls `work(from, to)` for each group i.e. items in [from, to),
+// on `n_threads` worker threads ( 0 denotes all available hardware threads ),
+// where calling thread is one of them. Workers keep claiming next group, till
+// all of them are processed, so that uneven groups don't leave workers idle.
+//
+// Other than calling thread, workers are helper threads of process wide pool (
+// see `shared_pool()` ), which are started once and reused across calls, so
+// that thread start-up cost is not paid by each call to `tree_hash(...)`,
+// `seal_chunked(...)`/ `open_chunked(...)` or batched routines of shared
+// library object. So # -of worker threads is capped at # -of available
+// hardware threads. No more workers are used than there are groups, so when
+// there's single group ( or single thread is requested ), work is done on
+// calling thread, without touching the pool.
+template<typename fn_t>
+static inline void
+parallel_for(const size_t n_items,
+             const size_t group,
+             const size_t n_threads,
+             fn_t&& work)
+{
+  const size_t groups = (n_items + group - 1) / group;
+
+  size_t threads = n_threads;
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  threads = std::clamp<size_t>(threads, 1, std::max<size_t>(groups, 1));
+
+  if (threads == 1) {
+    work(0, n_items);
+    return;
+  }
+
+  thread_pool_t& pool = shared_pool();
+
+  pool_job_t job;
+  job.n_items = n_items;
+  job.group = group;
+  job.ctx = const_cast<void*>(static_cast<const void*>(&work));
+  job.run = [](void* const ctx, const size_t from, const size_t to) {
+    (*static_cast<std::remove_reference_t<fn_t>*>(ctx))(from, to);
+  };
+
+  pool.run(job, std::min(threads - 1, pool.size()));
+}
+
+}
@@ -0,0 +1,352 @@
+#pragma once
+#include "aead.hpp"
+#include "hasher.hpp"
+#include <span>
+#include <type_traits>
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define XOODYAK_IOVEC
+#endif
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Scatter-gather input/ output i.e. message, associated data, plain/ cipher
+// text described as list of segments ( of arbitrary, possibly zero, length ),
+// which are logically concatenated, so that chained buffers ( say delivered by
+// network stack ) don't need to be linearized before hashing/ encrypting them.
+namespace sg {
+
+using in_seg_t = std::span<const uint8_t>;
+using out_seg_t = std::span<uint8_t>;
+
+static inline const uint8_t*
+seg_data(const in_seg_t s)
+{
+  return s.data();
+}
+
+static inline uint8_t*
+seg_data(const out_seg_t s)
+{
+  return s.data();
+}
+
+static inline size_t
+seg_size(const in_seg_t s)
+{
+  return s.size();
+}
+
+static inline size_t
+seg_size(const out_seg_t s)
+{
+  return s.size();
+}
+
+#if defined XOODYAK_IOVEC
+
+static inline uint8_t*
+seg_data(const iovec& v)
+{
+  return static_cast<uint8_t*>(v.iov_base);
+}
+
+static inline size_t
+seg_size(const iovec& v)
+{
+  return v.iov_len;
+}
+
+#endif
+
+// Returns total length of all segments
+template<typename seg_t>
+static inline size_t
+total_size(const seg_t* const segs, const size_t cnt)
+{
+  size_t len = 0ul;
+  for (size_t i = 0; i < cnt; i++) {
+    len += seg_size(segs[i]);
+  }
+
+  return len;
+}
+
+// Walks two segment lists side by side, calling `fn(in, out, len)` for each
+// maximal piece which lies within a single segment of both lists, so that input
+// and output segment boundaries don't need to line up. Both lists must be of
+// same total length ( checked by caller ), otherwise only shorter prefix is
+// walked.
+template<typename in_t, typename out_t, typename fn_t>
+static inline void
+zip(const in_t* const in,
+    const size_t in_cnt,
+    const out_t* const out,
+    const size_t out_cnt,
+    fn_t&& fn)
+{
+  size_t i = 0ul, j = 0ul;
+  size_t i_off = 0ul, j_off = 0ul;
+
+  while ((i < in_cnt) && (j < out_cnt)) {
+    const size_t i_rem = seg_size(in[i]) - i_off;
+    const size_t j_rem = seg_size(out[j]) - j_off;
+
+    if (i_rem == 0ul) {
+      i++;
+      i_off = 0ul;
+      continue;
+    }
+
+    if (j_rem == 0ul) {
+      j++;
+      j_off = 0ul;
+      continue;
+    }
+
+    const size_t len = std::min(i_rem, j_rem);
+    fn(seg_data(in[i]) + i_off, seg_data(out[j]) + j_off, len);
+
+    i_off += len;
+    j_off += len;
+  }
+}
+
+// Hashes all message segments, using single contiguous buffer routine, when
+// there's at max one segment, otherwise using incremental hasher
+template<typename seg_t>
+static inline void
+hash(const seg_t* const msg, const size_t cnt, uint8_t* const __restrict out)
+{
+  if (cnt <= 1ul) {
+    const uint8_t* const m = cnt == 0ul ? nullptr : seg_data(msg[0]);
+    const size_t m_len = cnt == 0ul ? 0ul : seg_size(msg[0]);
+
+    xoodyak::hash(m, m_len, out);
+    return;
+  }
+
+  hasher_t h;
+  for (size_t i = 0; i < cnt; i++) {
+    h.update(seg_data(msg[i]), seg_size(msg[i]));
+  }
+  h.finalize(out);
+}
+
+// Encrypts/ decrypts ( based on template parameter's truthness ) segmented
+// input into segmented output, after absorbing segmented associated data,
+// using one-shot routines, when each of them is ( at max ) a single segment,
+// otherwise using online AEAD context, which handles Cyclist block splits
+// across segment boundaries. Returns truth value, denoting whether computed
+// tag matches expected one, when decrypting; on failure, output is zeroed.
+//
+// Returns false, without touching output ( or tag ), if total length of input
+// segments is not same as that of output segments.
+//
+// Segments must not overlap, except that single input segment and single output
+// segment may be the very same buffer, which is encrypted/ decrypted in-place.
+template<const bool decrypt, typename in_seg, typename out_seg>
+static inline bool
+aead(const uint8_t* const __restrict key,
+     const uint8_t* const __restrict nonce,
+     const in_seg* const data,
+     const size_t data_cnt,
+     const in_seg* const in,
+     const size_t in_cnt,
+     const out_seg* const out,
+     const size_t out_cnt,
+     std::conditional_t<decrypt, const uint8_t, uint8_t>* const __restrict tag)
+{
+  const size_t io_len = total_size(in, in_cnt);
+  if (io_len != total_size(out, out_cnt)) {
+    return false;
+  }
+
+  const bool single = (data_cnt <= 1ul) && (in_cnt <= 1ul) && (out_cnt <= 1ul);
+  if (single) {
+    const uint8_t* const d = data_cnt == 0ul ? nullptr : seg_data(data[0]);
+    const size_t dt_len = data_cnt == 0ul ? 0ul : seg_size(data[0]);
+    const uint8_t* const i = in_cnt == 0ul ? nullptr : seg_data(in[0]);
+    uint8_t* const o = out_cnt == 0ul ? nullptr : seg_data(out[0]);
+
+    // in-place, when input & output is same buffer, as one-shot routines
+    // take them as `__restrict` pointers
+    if constexpr (decrypt) {
+      if (i == o) {
+        return xoodyak::decrypt_inplace(key, nonce, tag, d, dt_len, o, io_len);
+      }
+      return xoodyak::decrypt(key, nonce, tag, d, dt_len, i, o, io_len);
+    } else {
+      if (i == o) {
+        xoodyak::encrypt_inplace(key, nonce, d, dt_len, o, io_len, tag);
+      } else {
+        xoodyak::encrypt(key, nonce, d, dt_len, i, o, io_len, tag);
+      }
+      return true;
+    }
+  }
+
+  aead_t ctx(key, nonce);
+
+  for (size_t k = 0; k < data_cnt; k++) {
+    ctx.absorb_ad(seg_data(data[k]), seg_size(data[k]));
+  }
+
+  zip(in,
+      in_cnt,
+      out,
+      out_cnt,
+      [&](const uint8_t* const i, uint8_t* const o, const size_t len) {
+        if constexpr (decrypt) {
+          ctx.decrypt_update(i, o, len);
+        } else {
+          ctx.encrypt_update(i, o, len);
+        }
+      });
+
+  if constexpr (decrypt) {
+    const bool f = ctx.verify(tag);
+
+    // don't release unverified plain text !
+    for (size_t k = 0; !f && (k < out_cnt); k++) {
+      std::memset(seg_data(out[k]), 0, seg_size(out[k]));
+    }
+
+    return f;
+  } else {
+    ctx.finalize(tag);
+    return true;
+  }
+}
+
+}
+
+// Xoodyak cryptographic hash function, which computes 32 -bytes digest of
+// message, given as list of segments, same as `hash(...)` computes on all
+// segments, concatenated
+static inline void
+hashv(const std::span<const sg::in_seg_t> msg, // message segments
+      uint8_t* const __restrict out            // 32 -bytes digest
+)
+{
+  sg::hash(msg.data(), msg.size(), out);
+}
+
+// Xoodyak AEAD routine, which takes associated data, plain text and cipher text
+// as lists of segments ( of arbitrary, possibly different, boundaries ), while
+// computing same cipher text and tag as `encrypt(...)` computes on segments,
+// concatenated. Returns false, without encrypting anything, if total length of
+// plain text and cipher text segments differ.
+//
+// Note, segments must not overlap, except that single plain text segment and
+// single cipher text segment may be the very same buffer ( i.e. in-place ).
+static inline bool
+encryptv(const uint8_t* const __restrict key,      // 128 -bit secret key
+         const uint8_t* const __restrict nonce,    // 128 -bit message nonce
+         const std::span<const sg::in_seg_t> data, // associated data segments
+         const std::span<const sg::in_seg_t> text, // plain text segments
+         const std::span<const sg::out_seg_t> cipher, // cipher text segments
+         uint8_t* const __restrict tag                // 128 -bit tag
+)
+{
+  return sg::aead<false>(key,
+                         nonce,
+                         data.data(),
+                         data.size(),
+                         text.data(),
+                         text.size(),
+                         cipher.data(),
+                         cipher.size(),
+                         tag);
+}
+
+// Xoodyak Verified Decryption routine, which takes associated data, cipher text
+// and plain text as lists of segments, while computing same plain text as
+// `decrypt(...)` computes on segments, concatenated, returning boolean flag
+// denoting verification status. Returns false, without decrypting anything, if
+// total length of cipher text and plain text segments differ.
+//
+// Note, segments must not overlap, except that single cipher text segment and
+// single plain text segment may be the very same buffer ( i.e. in-place ). If
+// verification fails, all plain text segments are zeroed.
+static inline bool
+decryptv(const uint8_t* const __restrict key,        // 128 -bit secret key
+         const uint8_t* const __restrict nonce,      // 128 -bit message nonce
+         const uint8_t* const __restrict tag,        // 128 -bit tag
+         const std::span<const sg::in_seg_t> data,   // associated data segments
+         const std::span<const sg::in_seg_t> cipher, // cipher text segments
+         const std::span<const sg::out_seg_t> text   // plain text segments
+)
+{
+  return sg::aead<true>(key,
+                        nonce,
+                        data.data(),
+                        data.size(),
+                        cipher.data(),
+                        cipher.size(),
+                        text.data(),
+                        text.size(),
+                        tag);
+}
+
+#if defined XOODYAK_IOVEC
+
+// Same as `hashv(...)`, taking message as POSIX `iovec` array
+static inline void
+hashv(const iovec* const msg,       // message segments
+      const size_t msg_cnt,         // # -of message segments
+      uint8_t* const __restrict out // 32 -bytes digest
+)
+{
+  sg::hash(msg, msg_cnt, out);
+}
+
+// Same as `encryptv(...)`, taking segments as POSIX `iovec` arrays, which must
+// not overlap, except for single plain text & cipher text segment being same
+static inline bool
+encryptv(const uint8_t* const __restrict key,   // 128 -bit secret key
+         const uint8_t* const __restrict nonce, // 128 -bit message nonce
+         const iovec* const data,               // associated data segments
+         const size_t data_cnt,                 // # -of data segments
+         const iovec* const text,               // plain text segments
+         const size_t text_cnt,                 // # -of plain text segments
+         const iovec* const cipher,             // cipher text segments
+         const size_t cipher_cnt,               // # -of cipher text segments
+         uint8_t* const __restrict tag          // 128 -bit tag
+)
+{
+  return sg::aead<false>(
+    key, nonce, data, data_cnt, text, text_cnt, cipher, cipher_cnt, tag);
+}
+
+// Same as `decryptv(...)`, taking segments as POSIX `iovec` arrays, which must
+// not overlap, except for single cipher text & plain text segment being same
+static inline bool
+decryptv(const uint8_t* const __restrict key,   // 128 -bit secret key
+         const uint8_t* const __restrict nonce, // 128 -bit message nonce
+         const uint8_t* const __restrict tag,   // 128 -bit tag
+         const iovec* const data,               // associated data segments
+         const size_t data_cnt,                 // # -of data segments
+         const iovec* const cipher,             // cipher text segments
+         const size_t cipher_cnt,               // # -of cipher text segments
+         const iovec* const text,               // plain text segments
+         const size_t text_cnt                  // # -of plain text segments
+)
+{
+  return sg::aead<true>(key,
+                        nonce,
+                        data,
+                        data_cnt,
+                        cipher,
+                        cipher_cnt,
+                        text,
+                        text_cnt,
+                        tag);
+}
+
+#endif
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "xoodyak.hpp"
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Xoodyak session authenticated encryption context, for long-lived channels,
+// where secret key & nonce are absorbed only once, when session is started,
+// while each message ( read frame ) is processed as `Absorb(data) ->
+// Crypt(text) -> Squeeze(16)`, continuing from keyed state left behind by
+// previous frame. So authentication tag of a frame authenticates it along with
+// all preceding frames ( and their order ), while it costs no more than
+// absorbing associated data & encrypting plain text.
+//
+// Both ends of channel must seal/ open same sequence of frames ( and call
+// `ratchet()` at same points ), for their states to stay in sync. Once a frame
+// fails verification, states have diverged, so session refuses to process any
+// more frames.
+//
+// `ratchet()` irreversibly transforms keyed state, so that compromise of it
+// doesn't reveal frames processed before ratcheting ( i.e. forward secrecy ).
+//
+// See section 1.3.3 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+struct session_t
+{
+private:
+  alignas(16) uint32_t state[12]{};
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  bool broken = false;
+
+  // Processes single frame, encrypting/ decrypting ( based on template
+  // parameter's truthness ) M -bytes input & squeezing 16 -bytes tag, using
+  // register-resident engine, when executing CPU supports SSE2 ( or better )
+  template<const bool decrypt>
+  inline void frame(const uint8_t* const __restrict data,
+                    const size_t dt_len,
+                    const uint8_t* const in,
+                    uint8_t* const out,
+                    const size_t io_len,
+                    uint8_t* const __restrict tag)
+  {
+    static const auto fn =
+      cyclist::reg::frame_kernel<decrypt>(xoodoo::active_isa());
+    if (fn != nullptr) {
+      fn(state, ph == cyclist::phase_t::Down, data, dt_len, in, out, io_len, tag);
+      ph = cyclist::phase_t::Up;
+      return;
+    }
+
+    cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
+    cyclist::crypt_any<decrypt>(state, in, out, io_len, &ph);
+    cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag, 16ul, &ph);
+  }
+
+public:
+  // Starts session by absorbing 16 -bytes secret key & 16 -bytes nonce into
+  // permutation state, same as `encrypt(...)` does
+  inline session_t(const uint8_t* const __restrict key,  // 128 -bit secret key
+                   const uint8_t* const __restrict nonce // 128 -bit nonce
+  )
+  {
+    cyclist::absorb_key(state, key, nonce, &ph);
+  }
+
+  // Encrypts M -bytes plain text, after absorbing N -bytes associated data,
+  // computing 16 -bytes authentication tag, which authenticates this frame
+  // along with all preceding ones. Plain text and cipher text are allowed to
+  // be same buffer.
+  //
+  // Returns false ( without doing anything ), if session is already broken.
+  inline bool seal(const uint8_t* const __restrict data, // N (>=0) -bytes
+                   const size_t dt_len,                  // len(data)
+                   const uint8_t* const text,            // M (>=0) -bytes
+                   uint8_t* const cipher,                // M (>=0) -bytes
+                   const size_t ct_len,                  // len(text)
+                   uint8_t* const __restrict tag         // 128 -bit tag
+  )
+  {
+    if (broken) {
+      return false;
+    }
+
+    frame<false>(data, dt_len, text, cipher, ct_len, tag);
+    return true;
+  }
+
+  // Decrypts M -bytes cipher text, after absorbing N -bytes associated data,
+  // returning truth value only when computed authentication tag matches
+  // expected one. Cipher text and plain text are allowed to be same buffer.
+  //
+  // Note, if verification fails, plain text is zeroed & session is broken, so
+  // that all further calls to `seal(...)`/ `open(...)` return false.
+  inline bool open(const uint8_t* const __restrict tag,  // 128 -bit tag
+                   const uint8_t* const __restrict data, // N (>=0) -bytes
+                   const size_t dt_len,                  // len(data)
+                   const uint8_t* const cipher,          // M (>=0) -bytes
+                   uint8_t* const text,                  // M (>=0) -bytes
+                   const size_t ct_len                   // len(cipher)
+  )
+  {
+    if (broken) {
+      std::memset(text, 0, ct_len);
+      return false;
+    }
+
+    uint8_t tag_[16];
+    frame<true>(data, dt_len, cipher, text, ct_len, tag_);
+
+    uint8_t f = 0;
+    for (size_t i = 0; i < 16; i++) {
+      f |= tag[i] ^ tag_[i];
+    }
+
+    // don't release unverified plain text !
+    broken = f != 0;
+    std::memset(text, 0, broken * ct_len);
+    return !broken;
+  }
+
+  // Cyclist `Ratchet()` i.e. squeezes `l_ratchet` ( = 16 ) -bytes, using
+  // ratchet color, and absorbs them back into permutation state, which
+  // overwrites part of it, making this transformation irreversible.
+  //
+  // See algorithm 2 of Xoodyak specification.
+  inline void ratchet()
+  {
+    using cyclist::mode_t;
+
+    if (broken) {
+      return;
+    }
+
+    uint8_t r[cyclist::l_ratchet];
+
+    cyclist::squeeze_any<mode_t::Keyed, cyclist::R_Kout, cyclist::Ratchet_Color>(
+      state, r, sizeof(r), &ph);
+    cyclist::absorb_any<mode_t::Keyed, cyclist::R_Kin, cyclist::Zero_Color>(
+      state, r, sizeof(r), &ph);
+  }
+};
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "../../tool/mapped_file.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+// Ensure functional correctness of file input/ output, used by Xoodyak
+// command-line tools
+namespace test_tool {
+
+// Writes given bytes into file at path, replacing its content
+inline void
+write_file(const std::string& path, const std::vector<uint8_t>& bytes)
+{
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  assert(fd >= 0);
+
+  const ssize_t n = ::write(fd, bytes.data(), bytes.size());
+  assert(n == static_cast<ssize_t>(bytes.size()));
+
+  ::close(fd);
+}
+
+// Counts directory entries, except "." and ".."
+inline size_t
+dir_entries(const std::string& path)
+{
+  DIR* const dir = ::opendir(path.c_str());
+  assert(dir != nullptr);
+
+  size_t cnt = 0ul;
+  while (const dirent* const ent = ::readdir(dir)) {
+    const std::string name(ent->d_name);
+    cnt += (name != ".") && (name != "..");
+  }
+
+  ::closedir(dir);
+  return cnt;
+}
+
+// Test read-only file view, by asserting that regular files, which report
+// zero size, but have content ( as /proc files do ), are read till
+// end-of-file, while empty ones are still read as empty
+inline void
+mapped_file()
+{
+  {
+    const char* const path = "/proc/self/maps";
+
+    struct stat st;
+    if ((::stat(path, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size == 0)) {
+      const xoodyak_tool::mapped_file_t f(path);
+      assert(f.ok());
+      assert(f.len > 0ul);
+    }
+  }
+
+  {
+    char tmpl[] = "/tmp/xoodyak-test-XXXXXX";
+    const int fd = ::mkstemp(tmpl);
+    assert(fd >= 0);
+    ::close(fd);
+
+    const xoodyak_tool::mapped_file_t f(tmpl);
+    assert(f.ok());
+    assert(f.len == 0ul);
+
+    ::unlink(tmpl);
+  }
+}
+
+// Test writable file view, by asserting that an existing file at destination
+// path is left untouched ( and no temporary file is left behind ), when output
+// of given length is discarded, while it's replaced, when output is committed
+inline void
+mapped_out(const size_t len)
+{
+  char tmpl[] = "/tmp/xoodyak-test-XXXXXX";
+  const char* const dir = ::mkdtemp(tmpl);
+  assert(dir != nullptr);
+
+  const std::string path = std::string(dir) + "/out";
+
+  std::vector<uint8_t> old(37), data(len);
+  xoodyak_utils::random_data(old.data(), old.size());
+  xoodyak_utils::random_data(data.data(), data.size());
+
+  write_file(path, old);
+
+  {
+    xoodyak_tool::mapped_out_t out(path.c_str(), len, 0644);
+    assert(out.ok());
+
+    std::copy(data.begin(), data.end(), out.data);
+    out.discard();
+  }
+
+  {
+    const xoodyak_tool::mapped_file_t f(path.c_str());
+    assert(f.ok());
+    assert(std::equal(old.begin(), old.end(), f.data, f.data + f.len));
+    assert(dir_entries(dir) == 1ul);
+  }
+
+  {
+    xoodyak_tool::mapped_out_t out(path.c_str(), len, 0644);
+    assert(out.ok());
+
+    std::copy(data.begin(), data.end(), out.data);
+    assert(out.commit());
+  }
+
+  {
+    const xoodyak_tool::mapped_file_t f(path.c_str());
+    assert(f.ok());
+    assert(std::equal(data.begin(), data.end(), f.data, f.data + f.len));
+    assert(dir_entries(dir) == 1ul);
+  }
+
+  ::unlink(path.c_str());
+  ::rmdir(dir);
+}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "utils.hpp"
+#include "xoodoo_batch.hpp"
+#include <cassert>
+#include <utility>
+
+// Ensure functional correctness of all Xoodoo permutation implementations
+namespace test_xoodoo {
+
+// Test every single-state Xoodoo[n] permutation implementation, supported by
+// executing CPU, by asserting that it produces same output as portable one, on
+// randomly generated states
+template<const size_t n_rounds = xoodoo::ROUNDS>
+inline void
+permute()
+{
+  const auto max_isa = static_cast<uint8_t>(xoodoo::active_isa());
+
+  for (uint8_t i = 0; i <= max_isa; i++) {
+    const auto isa = static_cast<xoodoo::isa_t>(i);
+    const auto fn = xoodoo::permute_kernel<n_rounds>(isa);
+
+    uint32_t st[12];
+    uint32_t st_[12];
+
+    xoodyak_utils::random_data(st, 12);
+    std::memcpy(st_, st, sizeof(st));
+
+    fn(st);
+    xoodoo::scalar::permute<n_rounds>(st_);
+
+    for (size_t j = 0; j < 12; j++) {
+      assert(st[j] == st_[j]);
+    }
+  }
+}
+
+// Test given multi-state Xoodoo[n] permutation implementation, by asserting that
+// permuting N lane-transposed random states at once produces same output as
+// permuting each of them independently, using portable implementation
+template<const size_t N, const size_t n_rounds = xoodoo::ROUNDS>
+inline void
+permute_batch(const xoodoo::permute_batch_fn_t fn)
+{
+  uint32_t st[12 * N];
+  xoodyak_utils::random_data(st, 12 * N);
+
+  uint32_t st_[N][12];
+  for (size_t j = 0; j < N; j++) {
+    for (size_t i = 0; i < 12; i++) {
+      st_[j][i] = st[i * N + j];
+    }
+
+    xoodoo::scalar::permute<n_rounds>(st_[j]);
+  }
+
+  fn(st);
+
+  for (size_t j = 0; j < N; j++) {
+    for (size_t i = 0; i < 12; i++) {
+      assert(st[i * N + j] == st_[j][i]);
+    }
+  }
+}
+
+// Test every multi-state Xoodoo[n] permutation implementation, supported by
+// executing CPU
+template<const size_t n_rounds = xoodoo::ROUNDS>
+inline void
+permute_batch()
+{
+  const auto max_isa = static_cast<uint8_t>(xoodoo::active_isa());
+
+  for (uint8_t i = 0; i <= max_isa; i++) {
+    const auto isa = static_cast<xoodoo::isa_t>(i);
+
+    permute_batch<8, n_rounds>(xoodoo::permute_x8_kernel<n_rounds>(isa));
+    permute_batch<16, n_rounds>(xoodoo::permute_x16_kernel<n_rounds>(isa));
+  }
+
+  permute_batch<2, n_rounds>(xoodoo::permute_xN<2, n_rounds>);
+}
+
+// Test portable reduced round Xoodoo[n] permutation, by asserting that applying
+// first 12 - n rounds of Xoodoo[12], one by one, followed by Xoodoo[n] produces
+// same output as Xoodoo[12] does, i.e. Xoodoo[n] is made of last n rounds
+template<const size_t n_rounds>
+inline void
+permute_reduced()
+{
+  uint32_t st[12];
+  uint32_t st_[12];
+
+  xoodyak_utils::random_data(st, 12);
+  std::memcpy(st_, st, sizeof(st));
+
+  [&]<size_t... i>(std::index_sequence<i...>) {
+    (xoodoo::scalar::round<i>(st), ...);
+  }(std::make_index_sequence<xoodoo::ROUNDS - n_rounds>{});
+
+  xoodoo::scalar::permute<n_rounds>(st);
+  xoodoo::scalar::permute(st_);
+
+  for (size_t j = 0; j < 12; j++) {
+    assert(st[j] == st_[j]);
+  }
+}
+
+}
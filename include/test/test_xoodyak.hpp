@@ -1,6 +1,19 @@
 #pragma once
+#include "aead.hpp"
+#include "aead_batch.hpp"
+#include "chunked.hpp"
+#include "hash_batch.hpp"
+#include "hash_engine.hpp"
+#include "hasher.hpp"
+#include "key_schedule.hpp"
+#include "mac.hpp"
+#include "scatter_gather.hpp"
+#include "session.hpp"
+#include "tree_hash.hpp"
+#include "xof.hpp"
 #include "xoodyak.hpp"
 #include <cassert>
+#include <vector>
 
 // Ensure functional correctness of Xoodyak Authenticated Encryption with
 // Associated Data ( AEAD )
@@ -148,4 +161,1401 @@ aead(const size_t dt_len, const size_t ct_len, const mutate_t m)
   std::free(dec);
 }
 
+// Test Xoodyak multi-message hashing, by computing digests of N random, equal
+// length messages at once, while asserting that they're same as ones computed
+// by N independent calls to single message hash routine
+template<const size_t N>
+inline void
+hash_xN(const size_t m_len)
+{
+  uint8_t* msg = static_cast<uint8_t*>(std::malloc(N * m_len));
+  uint8_t* out = static_cast<uint8_t*>(std::malloc(N * xoodyak::DIGEST_LEN));
+  uint8_t* out_ = static_cast<uint8_t*>(std::malloc(xoodyak::DIGEST_LEN));
+
+  xoodyak_utils::random_data(msg, N * m_len);
+
+  const uint8_t* msg_ptr[N];
+  uint8_t* out_ptr[N];
+  for (size_t j = 0; j < N; j++) {
+    msg_ptr[j] = msg + j * m_len;
+    out_ptr[j] = out + j * xoodyak::DIGEST_LEN;
+  }
+
+  xoodyak::hash_xN<N>(msg_ptr, m_len, out_ptr);
+
+  for (size_t j = 0; j < N; j++) {
+    xoodyak::hash(msg_ptr[j], m_len, out_);
+
+    for (size_t i = 0; i < xoodyak::DIGEST_LEN; i++) {
+      assert(out_ptr[j][i] == out_[i]);
+    }
+  }
+
+  std::free(msg);
+  std::free(out);
+  std::free(out_);
+}
+
+// Test Xoodyak multi-message AEAD, by encrypting N random, equal length
+// messages at once, while asserting that cipher texts and tags are same as
+// ones computed by N independent calls to single message encrypt routine.
+// Finally all N messages are decrypted at once, with tag of one of them
+// mutated, to ensure verification failure is reported only for that message.
+template<const size_t N>
+inline void
+aead_xN(const size_t dt_len, const size_t ct_len)
+{
+  constexpr size_t knt_len = 16ul;
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(N * knt_len));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(N * knt_len));
+  uint8_t* tag = static_cast<uint8_t*>(std::malloc(N * knt_len));
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(N * dt_len));
+  uint8_t* text = static_cast<uint8_t*>(std::malloc(N * ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(N * ct_len));
+  uint8_t* dec = static_cast<uint8_t*>(std::malloc(N * ct_len));
+  uint8_t* tag_ = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* enc_ = static_cast<uint8_t*>(std::malloc(ct_len));
+
+  xoodyak_utils::random_data(key, N * knt_len);
+  xoodyak_utils::random_data(nonce, N * knt_len);
+  xoodyak_utils::random_data(data, N * dt_len);
+  xoodyak_utils::random_data(text, N * ct_len);
+
+  const uint8_t *key_ptr[N], *nonce_ptr[N], *tag_cptr[N], *data_ptr[N];
+  const uint8_t *text_ptr[N], *enc_cptr[N];
+  uint8_t *tag_ptr[N], *enc_ptr[N], *dec_ptr[N];
+
+  for (size_t j = 0; j < N; j++) {
+    key_ptr[j] = key + j * knt_len;
+    nonce_ptr[j] = nonce + j * knt_len;
+    tag_ptr[j] = tag + j * knt_len;
+    tag_cptr[j] = tag_ptr[j];
+    data_ptr[j] = data + j * dt_len;
+    text_ptr[j] = text + j * ct_len;
+    enc_ptr[j] = enc + j * ct_len;
+    enc_cptr[j] = enc_ptr[j];
+    dec_ptr[j] = dec + j * ct_len;
+  }
+
+  using namespace xoodyak;
+
+  encrypt_xN<N>(
+    key_ptr, nonce_ptr, data_ptr, dt_len, text_ptr, enc_ptr, ct_len, tag_ptr);
+
+  for (size_t j = 0; j < N; j++) {
+    encrypt(key_ptr[j],
+            nonce_ptr[j],
+            data_ptr[j],
+            dt_len,
+            text_ptr[j],
+            enc_,
+            ct_len,
+            tag_);
+
+    for (size_t i = 0; i < ct_len; i++) {
+      assert(enc_ptr[j][i] == enc_[i]);
+    }
+    for (size_t i = 0; i < knt_len; i++) {
+      assert(tag_ptr[j][i] == tag_[i]);
+    }
+  }
+
+  // mutate tag of last message, so that only its verification fails
+  tag_ptr[N - 1][0] ^= static_cast<uint8_t>(1);
+
+  bool flag[N];
+  decrypt_xN<N>(key_ptr,
+                nonce_ptr,
+                tag_cptr,
+                data_ptr,
+                dt_len,
+                enc_cptr,
+                dec_ptr,
+                ct_len,
+                flag);
+
+  for (size_t j = 0; j < N - 1; j++) {
+    assert(flag[j]);
+
+    for (size_t i = 0; i < ct_len; i++) {
+      assert(text_ptr[j][i] == dec_ptr[j][i]);
+    }
+  }
+
+  assert(!flag[N - 1]);
+  assert(is_zeros(dec_ptr[N - 1], ct_len));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(text);
+  std::free(enc);
+  std::free(dec);
+  std::free(tag_);
+  std::free(enc_);
+}
+
+// Test incremental Xoodyak hashing, by absorbing random message in randomly
+// sized chunks ( including empty ones ), while asserting that computed digest
+// is same as the one computed by one-shot hash routine
+inline void
+hasher(const size_t m_len)
+{
+  uint8_t* msg = static_cast<uint8_t*>(std::malloc(m_len));
+  uint8_t* out = static_cast<uint8_t*>(std::malloc(xoodyak::DIGEST_LEN));
+  uint8_t* out_ = static_cast<uint8_t*>(std::malloc(xoodyak::DIGEST_LEN));
+
+  xoodyak_utils::random_data(msg, m_len);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> dis(0ul, 2 * cyclist::R_Hash + 1);
+
+  xoodyak::hasher_t h;
+
+  size_t off = 0ul;
+  while (off < m_len) {
+    const size_t read = std::min(dis(gen), m_len - off);
+    h.update(msg + off, read);
+
+    off += read;
+  }
+
+  h.finalize(out);
+  xoodyak::hash(msg, m_len, out_);
+
+  for (size_t i = 0; i < xoodyak::DIGEST_LEN; i++) {
+    assert(out[i] == out_[i]);
+  }
+
+  std::free(msg);
+  std::free(out);
+  std::free(out_);
+}
+
+// Test online Xoodyak AEAD context, by feeding it associated data and plain/
+// cipher text in randomly sized chunks ( including empty ones ), while asserting
+// that computed cipher text and tag are same as the ones computed by one-shot
+// encrypt routine, and that tag verification fails when it's mutated
+inline void
+aead_stream(const size_t dt_len, const size_t ct_len)
+{
+  constexpr size_t knt_len = 16ul;
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* tag = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* tag_ = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(dt_len));
+  uint8_t* text = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* enc_ = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* dec = static_cast<uint8_t*>(std::malloc(ct_len));
+
+  xoodyak_utils::random_data(key, knt_len);
+  xoodyak_utils::random_data(nonce, knt_len);
+  xoodyak_utils::random_data(data, dt_len);
+  xoodyak_utils::random_data(text, ct_len);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> dis(0ul, 2 * cyclist::R_Kin + 1);
+
+  xoodyak::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
+
+  xoodyak::aead_t enc_ctx(key, nonce);
+  xoodyak::aead_t dec_ctx(key, nonce);
+
+  size_t off = 0ul;
+  while (off < dt_len) {
+    const size_t read = std::min(dis(gen), dt_len - off);
+
+    assert(enc_ctx.absorb_ad(data + off, read));
+    assert(dec_ctx.absorb_ad(data + off, read));
+
+    off += read;
+  }
+
+  off = 0ul;
+  while (off < ct_len) {
+    const size_t read = std::min(dis(gen), ct_len - off);
+
+    assert(enc_ctx.encrypt_update(text + off, enc_ + off, read));
+    assert(dec_ctx.decrypt_update(enc + off, dec + off, read));
+
+    off += read;
+  }
+
+  // associated data can't be absorbed, once encryption/ decryption has started
+  // and direction can't be switched, in the middle of a message
+  if (ct_len > 0) {
+    assert(!enc_ctx.absorb_ad(data, dt_len));
+    assert(!dec_ctx.encrypt_update(text, enc_, ct_len));
+  }
+
+  enc_ctx.finalize(tag_);
+
+  for (size_t i = 0; i < ct_len; i++) {
+    assert(enc[i] == enc_[i]);
+    assert(text[i] == dec[i]);
+  }
+
+  for (size_t i = 0; i < knt_len; i++) {
+    assert(tag[i] == tag_[i]);
+  }
+
+  xoodyak::aead_t dec_ctx_(key, nonce);
+  dec_ctx_.absorb_ad(data, dt_len);
+  dec_ctx_.decrypt_update(enc, dec, ct_len);
+
+  tag[0] ^= 0x01;
+
+  assert(dec_ctx.verify(tag_));
+  assert(!dec_ctx_.verify(tag));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(tag_);
+  std::free(data);
+  std::free(text);
+  std::free(enc);
+  std::free(enc_);
+  std::free(dec);
+}
+
+// Test Xoodyak key schedule, by encrypting/ decrypting random message under
+// key schedule ( both one-shot and online ), while asserting that computed
+// cipher text, tag and deciphered text are same as the ones computed by
+// one-shot routines, taking secret key directly
+inline void
+key_schedule(const size_t dt_len, const size_t ct_len)
+{
+  constexpr size_t knt_len = 16ul;
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* tag = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* tag_ = static_cast<uint8_t*>(std::malloc(knt_len));
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(dt_len));
+  uint8_t* text = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* enc_ = static_cast<uint8_t*>(std::malloc(ct_len));
+  uint8_t* dec = static_cast<uint8_t*>(std::malloc(ct_len));
+
+  xoodyak_utils::random_data(key, knt_len);
+  xoodyak_utils::random_data(nonce, knt_len);
+  xoodyak_utils::random_data(data, dt_len);
+  xoodyak_utils::random_data(text, ct_len);
+
+  const xoodyak::key_schedule_t ks(key);
+
+  xoodyak::encrypt(key, nonce, data, dt_len, text, enc, ct_len, tag);
+  ks.encrypt(nonce, data, dt_len, text, enc_, ct_len, tag_);
+
+  for (size_t i = 0; i < ct_len; i++) {
+    assert(enc[i] == enc_[i]);
+  }
+
+  for (size_t i = 0; i < knt_len; i++) {
+    assert(tag[i] == tag_[i]);
+  }
+
+  xoodyak::aead_t ctx(ks, nonce);
+  ctx.absorb_ad(data, dt_len);
+  ctx.encrypt_update(text, enc_, ct_len);
+  ctx.finalize(tag_);
+
+  for (size_t i = 0; i < ct_len; i++) {
+    assert(enc[i] == enc_[i]);
+  }
+
+  for (size_t i = 0; i < knt_len; i++) {
+    assert(tag[i] == tag_[i]);
+  }
+
+  assert(ks.decrypt(nonce, tag, data, dt_len, enc, dec, ct_len));
+
+  for (size_t i = 0; i < ct_len; i++) {
+    assert(text[i] == dec[i]);
+  }
+
+  tag[0] ^= 0x01;
+
+  assert(!ks.decrypt(nonce, tag, data, dt_len, enc, dec, ct_len));
+  assert(is_zeros(dec, ct_len));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(tag_);
+  std::free(data);
+  std::free(text);
+  std::free(enc);
+  std::free(enc_);
+  std::free(dec);
+}
+
+// Test multi-buffer Xoodyak AEAD, by encrypting/ decrypting n messages of random
+// ( different ) lengths in a single call, while asserting that computed cipher
+// texts, tags and deciphered texts are same as the ones computed by one-shot
+// routines, and that only messages with mutated tags fail verification
+inline void
+aead_batch(const size_t n)
+{
+  constexpr size_t knt_len = 16ul;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> dt_dis(0ul, 3 * cyclist::R_Kin);
+  std::uniform_int_distribution<size_t> ct_dis(0ul, 8 * cyclist::R_Kout);
+
+  std::vector<std::vector<uint8_t>> key(n), nonce(n), data(n), text(n);
+  std::vector<std::vector<uint8_t>> enc(n), dec(n), tag(n), tag_(n);
+  std::vector<xoodyak::aead_desc_t> descs(n);
+  bool* flags = new bool[n];
+
+  for (size_t i = 0; i < n; i++) {
+    key[i].resize(knt_len);
+    nonce[i].resize(knt_len);
+    tag[i].resize(knt_len);
+    tag_[i].resize(knt_len);
+    data[i].resize(dt_dis(gen));
+    text[i].resize(ct_dis(gen));
+    enc[i].resize(text[i].size());
+    dec[i].resize(text[i].size());
+
+    xoodyak_utils::random_data(key[i].data(), knt_len);
+    xoodyak_utils::random_data(nonce[i].data(), knt_len);
+    xoodyak_utils::random_data(data[i].data(), data[i].size());
+    xoodyak_utils::random_data(text[i].data(), text[i].size());
+
+    descs[i] = { key[i].data(),  nonce[i].data(), data[i].data(),
+                 data[i].size(), text[i].data(),  enc[i].data(),
+                 text[i].size(), tag[i].data() };
+  }
+
+  xoodyak::encrypt_batch(descs.data(), n);
+
+  for (size_t i = 0; i < n; i++) {
+    std::vector<uint8_t> enc_(text[i].size());
+
+    xoodyak::encrypt(key[i].data(),
+                     nonce[i].data(),
+                     data[i].data(),
+                     data[i].size(),
+                     text[i].data(),
+                     enc_.data(),
+                     text[i].size(),
+                     tag_[i].data());
+
+    assert(enc[i] == enc_);
+    assert(tag[i] == tag_[i]);
+
+    descs[i].in = enc[i].data();
+    descs[i].out = dec[i].data();
+
+    // mutate tags of every third message
+    tag[i][0] ^= static_cast<uint8_t>(i % 3 == 0);
+  }
+
+  xoodyak::decrypt_batch(descs.data(), n, flags);
+
+  for (size_t i = 0; i < n; i++) {
+    if (i % 3 == 0) {
+      assert(!flags[i]);
+      assert(is_zeros(dec[i].data(), dec[i].size()));
+    } else {
+      assert(flags[i]);
+      assert(dec[i] == text[i]);
+    }
+  }
+
+  delete[] flags;
+}
+
+// Test multi-buffer Xoodyak hash, by hashing n messages in a single call, where
+// lengths are drawn from a narrow range ( so that many of them are of same
+// length ), while asserting that computed digests are same as the ones
+// computed by one-shot hash routine
+inline void
+hash_batch(const size_t n, const size_t max_len)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> dis(0ul, max_len);
+
+  std::vector<std::vector<uint8_t>> msg(n), dig(n);
+  std::vector<const uint8_t*> msg_ptr(n);
+  std::vector<uint8_t*> dig_ptr(n);
+  std::vector<size_t> m_len(n);
+
+  for (size_t i = 0; i < n; i++) {
+    m_len[i] = dis(gen);
+    msg[i].resize(m_len[i]);
+    dig[i].resize(xoodyak::DIGEST_LEN);
+
+    xoodyak_utils::random_data(msg[i].data(), m_len[i]);
+
+    msg_ptr[i] = msg[i].data();
+    dig_ptr[i] = dig[i].data();
+  }
+
+  xoodyak::hash_batch(msg_ptr.data(), m_len.data(), dig_ptr.data(), n);
+
+  std::vector<uint8_t> dig_(xoodyak::DIGEST_LEN);
+  for (size_t i = 0; i < n; i++) {
+    xoodyak::hash(msg[i].data(), m_len[i], dig_.data());
+    assert(dig[i] == dig_);
+  }
+}
+
+// Test Xoodyak parallel batch hashing engine, by hashing few batches of messages
+// of skewed lengths ( mostly short ones, along with few huge ones ), reusing
+// same engine ( i.e. worker pool ) across batches, while asserting that
+// computed digests are same as the ones computed by one-shot hash routine
+inline void
+hash_engine(const size_t n, const size_t n_large, const size_t n_threads)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> small(0ul, 200ul);
+  std::uniform_int_distribution<size_t> large(xoodyak::ENGINE_LARGE_LEN - 1,
+                                              1ul << 17);
+  std::uniform_int_distribution<size_t> pick(0ul, n);
+
+  xoodyak::hash_engine_t engine(n_threads);
+  assert(engine.threads() > 0);
+
+  for (size_t round = 0; round < 3; round++) {
+    const size_t cnt = n >> round;
+
+    std::vector<std::vector<uint8_t>> msg(cnt), dig(cnt);
+    std::vector<const uint8_t*> msg_ptr(cnt);
+    std::vector<uint8_t*> dig_ptr(cnt);
+    std::vector<size_t> m_len(cnt);
+
+    for (size_t i = 0; i < cnt; i++) {
+      m_len[i] = pick(gen) < n_large ? large(gen) : small(gen);
+      msg[i].resize(m_len[i]);
+      dig[i].resize(xoodyak::DIGEST_LEN);
+
+      xoodyak_utils::random_data(msg[i].data(), m_len[i]);
+
+      msg_ptr[i] = msg[i].data();
+      dig_ptr[i] = dig[i].data();
+    }
+
+    engine.hash(msg_ptr.data(), m_len.data(), dig_ptr.data(), cnt);
+
+    std::vector<uint8_t> dig_(xoodyak::DIGEST_LEN);
+    for (size_t i = 0; i < cnt; i++) {
+      xoodyak::hash(msg[i].data(), m_len[i], dig_.data());
+      assert(dig[i] == dig_);
+    }
+  }
+}
+
+// Test Xoodyak based parallel tree hash function, by hashing random message
+// using different number of worker threads, while asserting that computed
+// digest is same as the one computed by hashing leaves one after another, using
+// single permutation state, and that it's different from plain hash digest
+inline void
+tree_hash(const size_t m_len)
+{
+  using cyclist::mode_t;
+
+  constexpr size_t leaf_len = xoodyak::TREE_LEAF_LEN;
+  constexpr size_t dig_len = xoodyak::DIGEST_LEN;
+
+  std::vector<uint8_t> msg(m_len);
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  const size_t leaves = std::max<size_t>(1, (m_len + leaf_len - 1) / leaf_len);
+  std::vector<uint8_t> cvs(leaves * dig_len);
+
+  for (size_t i = 0; i < leaves; i++) {
+    const size_t off = i * leaf_len;
+    const size_t len = std::min(leaf_len, m_len - off);
+    const uint8_t sfx[cyclist::R_Hash]{}; // zero padded 1 -byte suffix
+
+    cyclist::phase_t ph = cyclist::phase_t::Up;
+    uint32_t state[12]{};
+
+    cyclist::absorb<mode_t::Hash>(state, msg.data() + off, len, &ph);
+    cyclist::absorb<mode_t::Hash>(state, sfx, 1, &ph);
+    cyclist::squeeze<mode_t::Hash>(state, cvs.data() + i * dig_len, dig_len, &ph);
+  }
+
+  uint8_t sfx[17]{};
+  for (size_t i = 0; i < 8; i++) {
+    sfx[i] = static_cast<uint8_t>(leaves >> (i << 3));
+    sfx[8 + i] = static_cast<uint8_t>(leaf_len >> (i << 3));
+  }
+  sfx[16] = 0x01;
+
+  uint8_t expected[dig_len];
+  {
+    cyclist::phase_t ph = cyclist::phase_t::Up;
+    uint32_t state[12]{};
+
+    cyclist::absorb<mode_t::Hash>(state, cvs.data(), cvs.size(), &ph);
+    cyclist::absorb<mode_t::Hash>(state, sfx, sizeof(sfx), &ph);
+    cyclist::squeeze<mode_t::Hash>(state, expected, dig_len, &ph);
+  }
+
+  for (size_t t = 1; t <= 4; t++) {
+    uint8_t computed[dig_len];
+    xoodyak::tree_hash(msg.data(), m_len, computed, t);
+
+    for (size_t i = 0; i < dig_len; i++) {
+      assert(computed[i] == expected[i]);
+    }
+  }
+
+  uint8_t plain[dig_len];
+  xoodyak::hash(msg.data(), m_len, plain);
+  assert(!std::equal(plain, plain + dig_len, expected));
+}
+
+// Test Xoodyak extendable output function, by absorbing random message and
+// squeezing o_len -bytes output in randomly sized chunks ( including empty
+// ones ), while asserting that output is same as the one computed by one-shot
+// XOF routine and its first 32 -bytes are same as hash digest
+inline void
+xof(const size_t m_len, const size_t o_len)
+{
+  std::vector<uint8_t> msg(m_len);
+  std::vector<uint8_t> out(o_len);
+  std::vector<uint8_t> out_(o_len);
+
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> dis(0ul, 2 * cyclist::R_Hash + 1);
+
+  xoodyak::xof_t x;
+
+  size_t off = 0ul;
+  while (off < m_len) {
+    const size_t read = std::min(dis(gen), m_len - off);
+    x.absorb(msg.data() + off, read);
+
+    off += read;
+  }
+
+  off = 0ul;
+  while (off < o_len) {
+    const size_t read = std::min(dis(gen), o_len - off);
+    x.squeeze(out.data() + off, read);
+
+    off += read;
+  }
+
+  xoodyak::xof(msg.data(), m_len, out_.data(), o_len);
+  assert(out == out_);
+
+  if (o_len >= xoodyak::DIGEST_LEN) {
+    uint8_t dig[xoodyak::DIGEST_LEN];
+    xoodyak::hash(msg.data(), m_len, dig);
+
+    assert(std::equal(dig, dig + xoodyak::DIGEST_LEN, out.begin()));
+  }
+}
+
+// Test in-place Xoodyak AEAD, by encrypting/ decrypting random message in place,
+// while asserting that computed cipher text and tag are same as the ones
+// computed by out-of-place routines, and that buffer is zeroed when tag
+// verification fails
+inline void
+aead_inplace(const size_t dt_len, const size_t ct_len)
+{
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len), tag_(knt_len);
+  std::vector<uint8_t> data(dt_len), text(ct_len), enc(ct_len), buf(ct_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(text.data(), ct_len);
+
+  xoodyak::encrypt(key.data(),
+                   nonce.data(),
+                   data.data(),
+                   dt_len,
+                   text.data(),
+                   enc.data(),
+                   ct_len,
+                   tag.data());
+
+  buf = text;
+  xoodyak::encrypt_inplace(key.data(),
+                           nonce.data(),
+                           data.data(),
+                           dt_len,
+                           buf.data(),
+                           ct_len,
+                           tag_.data());
+
+  assert(buf == enc);
+  assert(tag == tag_);
+
+  assert(xoodyak::decrypt_inplace(key.data(),
+                                  nonce.data(),
+                                  tag.data(),
+                                  data.data(),
+                                  dt_len,
+                                  buf.data(),
+                                  ct_len));
+  assert(buf == text);
+
+  buf = enc;
+  tag[0] ^= 0x01;
+
+  assert(!xoodyak::decrypt_inplace(key.data(),
+                                   nonce.data(),
+                                   tag.data(),
+                                   data.data(),
+                                   dt_len,
+                                   buf.data(),
+                                   ct_len));
+  assert(is_zeros(buf.data(), ct_len));
+}
+
+// Test every register-resident Cyclist engine, supported by executing CPU, by
+// asserting that it produces same hash digest, cipher text, tag and deciphered
+// text as the memory-resident Cyclist routines do, on random input
+inline void
+cyclist_reg(const size_t dt_len, const size_t ct_len)
+{
+  using cyclist::mode_t;
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len), tag_(knt_len);
+  std::vector<uint8_t> data(dt_len), text(ct_len), enc(ct_len), enc_(ct_len);
+  std::vector<uint8_t> dec(ct_len), dig(xoodyak::DIGEST_LEN);
+  std::vector<uint8_t> dig_(xoodyak::DIGEST_LEN);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(text.data(), ct_len);
+
+  {
+    cyclist::phase_t ph = cyclist::phase_t::Up;
+    uint32_t state[12]{};
+
+    cyclist::absorb<mode_t::Hash>(state, text.data(), ct_len, &ph);
+    cyclist::squeeze<mode_t::Hash>(state, dig.data(), dig.size(), &ph);
+  }
+
+  {
+    cyclist::phase_t ph = cyclist::phase_t::Up;
+    uint32_t state[12]{};
+
+    cyclist::absorb_key(state, key.data(), nonce.data(), &ph);
+    cyclist::absorb<mode_t::Keyed>(state, data.data(), dt_len, &ph);
+    cyclist::encrypt(state, text.data(), enc.data(), ct_len, &ph);
+    cyclist::squeeze<mode_t::Keyed>(state, tag.data(), knt_len, &ph);
+  }
+
+  const auto max_isa = static_cast<uint8_t>(xoodoo::active_isa());
+
+  for (uint8_t i = 0; i <= max_isa; i++) {
+    const auto isa = static_cast<xoodoo::isa_t>(i);
+
+    const auto hash_fn = cyclist::reg::hash_kernel(isa);
+    const auto enc_fn = cyclist::reg::aead_kernel<false>(isa);
+    const auto dec_fn = cyclist::reg::aead_kernel<true>(isa);
+
+    if (hash_fn == nullptr) {
+      continue;
+    }
+
+    hash_fn(text.data(), ct_len, dig_.data());
+    assert(dig == dig_);
+
+    enc_fn(key.data(),
+           nonce.data(),
+           data.data(),
+           dt_len,
+           text.data(),
+           enc_.data(),
+           ct_len,
+           tag_.data());
+    assert(enc == enc_);
+    assert(tag == tag_);
+
+    dec_fn(key.data(),
+           nonce.data(),
+           data.data(),
+           dt_len,
+           enc.data(),
+           dec.data(),
+           ct_len,
+           tag_.data());
+    assert(dec == text);
+    assert(tag == tag_);
+  }
+}
+
+// Test compile-time evaluable Xoodyak hash, by computing digest of known message
+// ( see example/xoodyak_hash.cpp ) at compile-time and comparing it against
+// known digest, while also asserting that, for random message, it computes
+// same digest as run-time hash routine does
+inline void
+hash_constexpr(const size_t m_len)
+{
+  constexpr std::array<uint8_t, 64> kat_msg{
+    0x55, 0x03, 0x98, 0xb8, 0x21, 0xa1, 0x91, 0x54,
+    0x61, 0xc0, 0x61, 0x93, 0x5f, 0x43, 0xb6, 0x42,
+    0x44, 0xf0, 0x0b, 0xf7, 0xb5, 0xe3, 0x25, 0xd6,
+    0x1e, 0xbb, 0xa4, 0xaa, 0x1a, 0xcf, 0x82, 0x45,
+    0x58, 0x15, 0xb4, 0x60, 0x5e, 0x57, 0xbe, 0x4c,
+    0x2a, 0xec, 0x85, 0xc1, 0x30, 0x74, 0x42, 0x4a,
+    0xe1, 0xcd, 0x68, 0x8d, 0x28, 0xf6, 0x37, 0xae,
+    0x9e, 0x7a, 0xe2, 0x90, 0x0b, 0x76, 0x42, 0x82
+  };
+  constexpr std::array<uint8_t, xoodyak::DIGEST_LEN> kat_dig{
+    0xcf, 0x90, 0xc7, 0x27, 0x93, 0x3c, 0x5e, 0x68,
+    0x55, 0x5e, 0x8f, 0x27, 0xc7, 0x44, 0x01, 0x92,
+    0x85, 0x4d, 0x47, 0x6f, 0x43, 0x6a, 0xb5, 0xb4,
+    0xd2, 0x7c, 0x7d, 0xf3, 0xed, 0x5f, 0xda, 0xfd
+  };
+
+  static_assert(xoodyak::hash(kat_msg) == kat_dig, "compile-time hash is wrong");
+  static_assert(xoodyak::hash("") == xoodyak::hash(std::array<uint8_t, 0>{}),
+                "compile-time hash of string is wrong");
+
+  std::vector<uint8_t> msg(m_len);
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  uint8_t dig[xoodyak::DIGEST_LEN];
+  xoodyak::hash(msg.data(), m_len, dig);
+
+  const auto dig_ = xoodyak::ct::hash(msg.data(), m_len);
+  assert(std::equal(dig, dig + xoodyak::DIGEST_LEN, dig_.begin()));
+}
+
+// Test Xoodyak message authentication code, by absorbing random message in
+// randomly sized chunks ( including empty ones ), while asserting that computed
+// tag is same as the one computed by one-shot and multi-message routines, and
+// that verification fails, when single bit of message or tag is flipped
+inline void
+mac(const size_t m_len, const size_t t_len)
+{
+  constexpr size_t knt_len = 16ul;
+  constexpr size_t N = 8ul;
+
+  std::vector<uint8_t> key(knt_len), msg(m_len), tag(t_len), tag_(t_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> dis(0ul, 2 * cyclist::R_Kin + 1);
+
+  xoodyak::mac_t m(key.data());
+
+  size_t off = 0ul;
+  while (off < m_len) {
+    const size_t read = std::min(dis(gen), m_len - off);
+    m.update(msg.data() + off, read);
+
+    off += read;
+  }
+
+  m.finalize(tag.data(), t_len);
+
+  xoodyak::mac(key.data(), msg.data(), m_len, tag_.data(), t_len);
+  assert(tag == tag_);
+  assert(xoodyak::mac_verify(key.data(), msg.data(), m_len, tag.data(), t_len));
+
+  {
+    xoodyak::mac_t m_(key.data());
+    m_.update(msg.data(), m_len);
+    assert(m_.verify(tag.data(), t_len));
+    assert(!m_.verify(tag.data(), t_len));
+  }
+
+  tag_[t_len - 1] ^= 0x80;
+  assert(!xoodyak::mac_verify(key.data(), msg.data(), m_len, tag_.data(), t_len));
+
+  // very short tags collide with non-negligible probability
+  if ((m_len > 0) && (t_len >= 8)) {
+    msg[0] ^= 0x01;
+    assert(!xoodyak::mac_verify(key.data(), msg.data(), m_len, tag.data(), t_len));
+    msg[0] ^= 0x01;
+  }
+
+  // multi-message routine, where one of the messages is the one above
+  std::vector<uint8_t> keys(N * knt_len), msgs(N * m_len), tags(N * t_len);
+
+  xoodyak_utils::random_data(keys.data(), keys.size());
+  xoodyak_utils::random_data(msgs.data(), msgs.size());
+  std::copy(key.begin(), key.end(), keys.begin());
+  std::copy(msg.begin(), msg.end(), msgs.begin());
+
+  const uint8_t* key_ptr[N];
+  const uint8_t* msg_ptr[N];
+  uint8_t* tag_ptr[N];
+
+  for (size_t j = 0; j < N; j++) {
+    key_ptr[j] = keys.data() + j * knt_len;
+    msg_ptr[j] = msgs.data() + j * m_len;
+    tag_ptr[j] = tags.data() + j * t_len;
+  }
+
+  xoodyak::mac_xN<N>(key_ptr, msg_ptr, m_len, tag_ptr, t_len);
+
+  for (size_t j = 0; j < N; j++) {
+    xoodyak::mac(key_ptr[j], msg_ptr[j], m_len, tag_.data(), t_len);
+    assert(std::equal(tag_.begin(), tag_.end(), tag_ptr[j]));
+  }
+
+  assert(std::equal(tag.begin(), tag.end(), tag_ptr[0]));
+}
+
+// Test multi-buffer Xoodyak message authentication code, by computing tags of n
+// messages, of random ( different ) message and tag lengths ( including empty
+// messages, multi-block messages and multi-block tags ), in a single call,
+// while asserting that computed tags are same as the ones computed by one-shot
+// routine
+inline void
+mac_batch(const size_t n)
+{
+  constexpr size_t knt_len = 16ul;
+
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> m_dis(0ul, 5 * cyclist::R_Kin);
+  std::uniform_int_distribution<size_t> t_dis(1ul, 3 * cyclist::R_Kout);
+
+  std::vector<std::vector<uint8_t>> key(n), msg(n), tag(n);
+  std::vector<xoodyak::mac_desc_t> descs(n);
+
+  for (size_t i = 0; i < n; i++) {
+    key[i].resize(knt_len);
+    msg[i].resize(m_dis(gen));
+    tag[i].resize(t_dis(gen));
+
+    xoodyak_utils::random_data(key[i].data(), knt_len);
+    xoodyak_utils::random_data(msg[i].data(), msg[i].size());
+
+    descs[i] = { key[i].data(),
+                 msg[i].data(),
+                 msg[i].size(),
+                 tag[i].data(),
+                 tag[i].size() };
+  }
+
+  xoodyak::mac_batch(descs.data(), n);
+
+  for (size_t i = 0; i < n; i++) {
+    std::vector<uint8_t> tag_(tag[i].size());
+
+    xoodyak::mac(key[i].data(),
+                 msg[i].data(),
+                 msg[i].size(),
+                 tag_.data(),
+                 tag_.size());
+    assert(tag[i] == tag_);
+  }
+}
+
+// Test Xoodyak session mode, by sealing/ opening few frames of random data,
+// with state ratcheted after every other frame, while asserting that computed
+// cipher texts and tags are same as the ones computed by calling Cyclist
+// routines directly, on a single keyed state, that first frame is same as
+// one-shot `encrypt(...)`, and that once a frame fails verification, session
+// refuses to open any more frames
+inline void
+session(const size_t dt_len, const size_t ct_len)
+{
+  using cyclist::mode_t;
+
+  constexpr size_t knt_len = 16ul;
+  constexpr size_t frames = 5ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len);
+  std::vector<uint8_t> data(dt_len), text(ct_len), enc(ct_len), dec(ct_len);
+  std::vector<uint8_t> tag(knt_len), enc_(ct_len), tag_(knt_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+
+  xoodyak::session_t sender(key.data(), nonce.data());
+  xoodyak::session_t receiver(key.data(), nonce.data());
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  cyclist::absorb_key(state, key.data(), nonce.data(), &ph);
+
+  for (size_t f = 0; f < frames; f++) {
+    xoodyak_utils::random_data(data.data(), dt_len);
+    xoodyak_utils::random_data(text.data(), ct_len);
+
+    assert(sender.seal(
+      data.data(), dt_len, text.data(), enc.data(), ct_len, tag.data()));
+
+    cyclist::absorb<mode_t::Keyed>(state, data.data(), dt_len, &ph);
+    cyclist::encrypt(state, text.data(), enc_.data(), ct_len, &ph);
+    cyclist::squeeze<mode_t::Keyed>(state, tag_.data(), knt_len, &ph);
+
+    assert(enc == enc_);
+    assert(tag == tag_);
+
+    if (f == 0) {
+      xoodyak::encrypt(key.data(),
+                       nonce.data(),
+                       data.data(),
+                       dt_len,
+                       text.data(),
+                       enc_.data(),
+                       ct_len,
+                       tag_.data());
+
+      assert(enc == enc_);
+      assert(tag == tag_);
+    }
+
+    assert(receiver.open(
+      tag.data(), data.data(), dt_len, enc.data(), dec.data(), ct_len));
+    assert(text == dec);
+
+    if (f & 1) {
+      uint8_t r[cyclist::l_ratchet];
+
+      cyclist::squeeze_any<mode_t::Keyed, cyclist::R_Kout, cyclist::Ratchet_Color>(
+        state, r, sizeof(r), &ph);
+      cyclist::absorb_any<mode_t::Keyed, cyclist::R_Kin, cyclist::Zero_Color>(
+        state, r, sizeof(r), &ph);
+
+      sender.ratchet();
+      receiver.ratchet();
+    }
+  }
+
+  // in-place sealing/ opening
+  xoodyak_utils::random_data(text.data(), ct_len);
+  dec = text;
+
+  assert(sender.seal(data.data(), dt_len, dec.data(), dec.data(), ct_len, tag.data()));
+  assert(receiver.open(
+    tag.data(), data.data(), dt_len, dec.data(), dec.data(), ct_len));
+  assert(text == dec);
+
+  // frame with mutated tag breaks the session
+  assert(sender.seal(
+    data.data(), dt_len, text.data(), enc.data(), ct_len, tag.data()));
+  tag[0] ^= 0x01;
+
+  assert(!receiver.open(
+    tag.data(), data.data(), dt_len, enc.data(), dec.data(), ct_len));
+  assert(is_zeros(dec.data(), ct_len));
+
+  tag[0] ^= 0x01;
+
+  assert(!receiver.open(
+    tag.data(), data.data(), dt_len, enc.data(), dec.data(), ct_len));
+}
+
+// Test Xoodyak verify-before-decrypt routine ( and every register-resident
+// engine backing it, supported by executing CPU ), by asserting that it
+// computes same plain text as `decrypt(...)` does ( both out-of-place and in
+// place ), while leaving plain text buffer untouched, when tag or cipher text
+// is mutated. Also asserts that `crypt_discard()` leaves behind same state as
+// decrypting into caller's buffer does.
+inline void
+verify_then_decrypt(const size_t dt_len, const size_t ct_len)
+{
+  constexpr size_t knt_len = 16ul;
+  constexpr uint8_t canary = 0xa5;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len);
+  std::vector<uint8_t> data(dt_len), text(ct_len), enc(ct_len), dec(ct_len);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(text.data(), ct_len);
+
+  xoodyak::encrypt(key.data(),
+                   nonce.data(),
+                   data.data(),
+                   dt_len,
+                   text.data(),
+                   enc.data(),
+                   ct_len,
+                   tag.data());
+
+  {
+    cyclist::phase_t ph0 = cyclist::phase_t::Up, ph1 = cyclist::phase_t::Up;
+    uint32_t state0[12]{}, state1[12]{};
+
+    cyclist::absorb_key(state0, key.data(), nonce.data(), &ph0);
+    cyclist::absorb_key(state1, key.data(), nonce.data(), &ph1);
+
+    cyclist::decrypt(state0, enc.data(), dec.data(), ct_len, &ph0);
+    cyclist::crypt_discard(state1, enc.data(), ct_len, &ph1);
+
+    assert(std::equal(state0, state0 + 12, state1));
+    assert(ph0 == ph1);
+  }
+
+  const auto max_isa = static_cast<uint8_t>(xoodoo::active_isa());
+
+  for (uint8_t i = 0; i <= max_isa; i++) {
+    const auto fn = cyclist::reg::aead_verify_kernel(static_cast<xoodoo::isa_t>(i));
+    if (fn == nullptr) {
+      continue;
+    }
+
+    std::fill(dec.begin(), dec.end(), canary);
+    assert(fn(key.data(),
+              nonce.data(),
+              tag.data(),
+              data.data(),
+              dt_len,
+              enc.data(),
+              dec.data(),
+              ct_len));
+    assert(dec == text);
+  }
+
+  std::fill(dec.begin(), dec.end(), canary);
+  assert(xoodyak::verify_then_decrypt(key.data(),
+                                      nonce.data(),
+                                      tag.data(),
+                                      data.data(),
+                                      dt_len,
+                                      enc.data(),
+                                      dec.data(),
+                                      ct_len));
+  assert(dec == text);
+
+  dec = enc;
+  assert(xoodyak::verify_then_decrypt(key.data(),
+                                      nonce.data(),
+                                      tag.data(),
+                                      data.data(),
+                                      dt_len,
+                                      dec.data(),
+                                      dec.data(),
+                                      ct_len));
+  assert(dec == text);
+
+  // unverified plain text is never written
+  tag[0] ^= 0x01;
+  std::fill(dec.begin(), dec.end(), canary);
+
+  assert(!xoodyak::verify_then_decrypt(key.data(),
+                                       nonce.data(),
+                                       tag.data(),
+                                       data.data(),
+                                       dt_len,
+                                       enc.data(),
+                                       dec.data(),
+                                       ct_len));
+  assert(std::all_of(dec.begin(), dec.end(), [](auto b) { return b == canary; }));
+
+  tag[0] ^= 0x01;
+
+  if (ct_len > 0) {
+    enc[ct_len - 1] ^= 0x80;
+
+    assert(!xoodyak::verify_then_decrypt(key.data(),
+                                         nonce.data(),
+                                         tag.data(),
+                                         data.data(),
+                                         dt_len,
+                                         enc.data(),
+                                         dec.data(),
+                                         ct_len));
+    assert(std::all_of(dec.begin(), dec.end(), [](auto b) { return b == canary; }));
+  }
+}
+
+// Splits N -bytes buffer into randomly sized segments ( including empty ones ),
+// of at max `max_seg` -bytes each
+template<typename seg_t, typename T>
+inline std::vector<seg_t>
+random_segments(T* const buf, const size_t len, const size_t max_seg)
+{
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_int_distribution<size_t> dis(0ul, max_seg);
+
+  std::vector<seg_t> segs;
+
+  size_t off = 0ul;
+  while (off < len) {
+    const size_t read = std::min(dis(gen), len - off);
+    segs.emplace_back(buf + off, read);
+
+    off += read;
+  }
+
+  return segs;
+}
+
+// Test Xoodyak scatter-gather routines, by hashing/ encrypting/ decrypting
+// random message, split into randomly sized segments ( where boundaries of
+// plain text and cipher text segments don't line up ), both as `std::span` and
+// POSIX `iovec` lists, while asserting that computed digest, cipher text, tag
+// and deciphered text are same as the ones computed by contiguous buffer
+// routines, that plain text segments are zeroed when verification fails, that
+// input/ output segment lists of different total length are rejected and that
+// single segment can be encrypted/ decrypted in-place
+inline void
+scatter_gather(const size_t dt_len, const size_t ct_len, const size_t max_seg)
+{
+  using in_seg_t = xoodyak::sg::in_seg_t;
+  using out_seg_t = xoodyak::sg::out_seg_t;
+
+  constexpr size_t knt_len = 16ul;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), tag(knt_len), tag_(knt_len);
+  std::vector<uint8_t> data(dt_len), text(ct_len), enc(ct_len), enc_(ct_len);
+  std::vector<uint8_t> dec(ct_len), dig(xoodyak::DIGEST_LEN);
+  std::vector<uint8_t> dig_(xoodyak::DIGEST_LEN);
+
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(data.data(), dt_len);
+  xoodyak_utils::random_data(text.data(), ct_len);
+
+  xoodyak::hash(text.data(), ct_len, dig.data());
+  xoodyak::encrypt(key.data(),
+                   nonce.data(),
+                   data.data(),
+                   dt_len,
+                   text.data(),
+                   enc.data(),
+                   ct_len,
+                   tag.data());
+
+  const auto data_segs = random_segments<in_seg_t>(data.data(), dt_len, max_seg);
+  const auto text_segs = random_segments<in_seg_t>(text.data(), ct_len, max_seg);
+  const auto enc_segs = random_segments<in_seg_t>(enc.data(), ct_len, max_seg);
+  const auto enc_segs_ = random_segments<out_seg_t>(enc_.data(), ct_len, max_seg);
+  const auto dec_segs = random_segments<out_seg_t>(dec.data(), ct_len, max_seg);
+
+  xoodyak::hashv(text_segs, dig_.data());
+  assert(dig == dig_);
+
+  assert(xoodyak::encryptv(
+    key.data(), nonce.data(), data_segs, text_segs, enc_segs_, tag_.data()));
+  assert(enc == enc_);
+  assert(tag == tag_);
+
+  assert(xoodyak::decryptv(
+    key.data(), nonce.data(), tag.data(), data_segs, enc_segs, dec_segs));
+  assert(dec == text);
+
+#if defined XOODYAK_IOVEC
+  const auto data_iov = random_segments<iovec>(data.data(), dt_len, max_seg);
+  const auto text_iov = random_segments<iovec>(text.data(), ct_len, max_seg);
+  const auto enc_iov = random_segments<iovec>(enc.data(), ct_len, max_seg);
+  const auto enc_iov_ = random_segments<iovec>(enc_.data(), ct_len, max_seg);
+  const auto dec_iov = random_segments<iovec>(dec.data(), ct_len, max_seg);
+
+  std::fill(dig_.begin(), dig_.end(), 0);
+  std::fill(enc_.begin(), enc_.end(), 0);
+  std::fill(dec.begin(), dec.end(), 0);
+
+  xoodyak::hashv(text_iov.data(), text_iov.size(), dig_.data());
+  assert(dig == dig_);
+
+  assert(xoodyak::encryptv(key.data(),
+                           nonce.data(),
+                           data_iov.data(),
+                           data_iov.size(),
+                           text_iov.data(),
+                           text_iov.size(),
+                           enc_iov_.data(),
+                           enc_iov_.size(),
+                           tag_.data()));
+  assert(enc == enc_);
+  assert(tag == tag_);
+
+  assert(xoodyak::decryptv(key.data(),
+                           nonce.data(),
+                           tag.data(),
+                           data_iov.data(),
+                           data_iov.size(),
+                           enc_iov.data(),
+                           enc_iov.size(),
+                           dec_iov.data(),
+                           dec_iov.size()));
+  assert(dec == text);
+#endif
+
+  tag[0] ^= 0x01;
+
+  assert(!xoodyak::decryptv(
+    key.data(), nonce.data(), tag.data(), data_segs, enc_segs, dec_segs));
+  assert(is_zeros(dec.data(), ct_len));
+
+  // output one byte longer than input, which must be left untouched
+  tag[0] ^= 0x01;
+
+  std::vector<uint8_t> out(ct_len + 1, 0xff);
+  const out_seg_t out_segs[]{ out };
+  const auto tag_copy = tag_;
+
+  assert(!xoodyak::encryptv(
+    key.data(), nonce.data(), data_segs, text_segs, out_segs, tag_.data()));
+  assert(!xoodyak::decryptv(
+    key.data(), nonce.data(), tag.data(), data_segs, enc_segs, out_segs));
+  assert(tag_ == tag_copy);
+  assert(std::all_of(out.begin(), out.end(), [](auto b) { return b == 0xff; }));
+
+  // in-place, with single segment, being both input and output
+  std::vector<uint8_t> buf(text);
+  const in_seg_t data_in[]{ data };
+  const in_seg_t buf_in[]{ buf };
+  const out_seg_t buf_out[]{ buf };
+
+  assert(xoodyak::encryptv(
+    key.data(), nonce.data(), data_in, buf_in, buf_out, tag_.data()));
+  assert(buf == enc);
+  assert(tag_ == tag);
+
+  assert(xoodyak::decryptv(
+    key.data(), nonce.data(), tag.data(), data_in, buf_in, buf_out));
+  assert(buf == text);
+
+  buf = enc;
+  tag[0] ^= 0x01;
+
+  assert(!xoodyak::decryptv(
+    key.data(), nonce.data(), tag.data(), data_in, buf_in, buf_out));
+  assert(is_zeros(buf.data(), ct_len));
+}
+
+// Test chunked Xoodyak AEAD, by sealing random payload into container, using
+// given chunk length and # -of worker threads, while asserting that
+//
+// - container is same, no matter how many threads are used
+// - each chunk is same as the one computed by `encrypt(...)`, under derived
+//   nonce, with header as associated data
+// - whole container and each chunk ( random access ) can be opened
+// - flipping a bit of any chunk fails verification of only that chunk, while
+//   whole payload is zeroed, when opening whole container
+// - tampered header and truncated container are rejected
+inline void
+chunked(const size_t m_len, const size_t chunk_len, const size_t n_threads)
+{
+  constexpr size_t knt_len = 16ul;
+  constexpr size_t hdr_len = xoodyak::CHUNKED_HEADER_LEN;
+
+  std::vector<uint8_t> key(knt_len), nonce(knt_len), msg(m_len), dec(m_len);
+  xoodyak_utils::random_data(key.data(), knt_len);
+  xoodyak_utils::random_data(nonce.data(), knt_len);
+  xoodyak_utils::random_data(msg.data(), m_len);
+
+  const size_t s_len = xoodyak::chunked_sealed_len(m_len, chunk_len);
+  std::vector<uint8_t> sealed(s_len), sealed_(s_len);
+
+  assert(!xoodyak::seal_chunked(
+    key.data(), nonce.data(), msg.data(), m_len, sealed.data(), 0, n_threads));
+  assert(xoodyak::seal_chunked(key.data(),
+                               nonce.data(),
+                               msg.data(),
+                               m_len,
+                               sealed.data(),
+                               chunk_len,
+                               n_threads));
+  assert(xoodyak::seal_chunked(
+    key.data(), nonce.data(), msg.data(), m_len, sealed_.data(), chunk_len, 1));
+  assert(sealed == sealed_);
+
+  size_t m_len_ = 0, chunks = 0;
+  assert(xoodyak::chunked_info(sealed.data(), s_len, &m_len_, &chunks));
+  assert(m_len_ == m_len);
+  assert(chunks == std::max<size_t>(1, (m_len + chunk_len - 1) / chunk_len));
+
+  std::vector<uint8_t> enc(chunk_len), tag(knt_len), out(chunk_len);
+
+  for (size_t i = 0; i < chunks; i++) {
+    const size_t off = i * chunk_len;
+    const size_t len = std::min(chunk_len, m_len - off);
+    const uint8_t* const blk = sealed.data() + hdr_len + i * (chunk_len + 16);
+
+    std::vector<uint8_t> nonce_ = nonce;
+    for (size_t j = 0; j < 8; j++) {
+      nonce_[j] ^= static_cast<uint8_t>(i >> (j << 3));
+    }
+
+    xoodyak::encrypt(key.data(),
+                     nonce_.data(),
+                     sealed.data(),
+                     hdr_len,
+                     msg.data() + off,
+                     enc.data(),
+                     len,
+                     tag.data());
+
+    assert(std::equal(enc.begin(), enc.begin() + len, blk));
+    assert(std::equal(tag.begin(), tag.end(), blk + len));
+
+    size_t o_len = 0;
+    assert(xoodyak::open_chunk(
+      key.data(), sealed.data(), s_len, i, out.data(), &o_len));
+    assert(o_len == len);
+    assert(std::equal(out.begin(), out.begin() + len, msg.begin() + off));
+  }
+
+  size_t o_len = 0;
+  assert(!xoodyak::open_chunk(
+    key.data(), sealed.data(), s_len, chunks, out.data(), &o_len));
+
+  assert(xoodyak::open_chunked(
+    key.data(), sealed.data(), s_len, dec.data(), n_threads));
+  assert(dec == msg);
+
+  // tampered chunk
+  {
+    const size_t idx = chunks / 2;
+    const size_t t_off = hdr_len + idx * (chunk_len + 16);
+
+    sealed[t_off] ^= 0x01;
+
+    assert(!xoodyak::open_chunked(
+      key.data(), sealed.data(), s_len, dec.data(), n_threads));
+    assert(is_zeros(dec.data(), m_len));
+
+    assert(!xoodyak::open_chunk(
+      key.data(), sealed.data(), s_len, idx, out.data(), &o_len));
+
+    if (chunks > 1) {
+      assert(xoodyak::open_chunk(
+        key.data(), sealed.data(), s_len, (idx + 1) % chunks, out.data(), &o_len));
+    }
+
+    sealed[t_off] ^= 0x01;
+  }
+
+  // tampered header ( base nonce )
+  sealed[hdr_len - 1] ^= 0x80;
+  assert(!xoodyak::open_chunked(
+    key.data(), sealed.data(), s_len, dec.data(), n_threads));
+  sealed[hdr_len - 1] ^= 0x80;
+
+  // tampered header ( payload length ) & truncated container
+  sealed[8] ^= 0x01;
+  assert(!xoodyak::chunked_info(sealed.data(), s_len, &m_len_, &chunks));
+  sealed[8] ^= 0x01;
+
+  assert(!xoodyak::open_chunked(
+    key.data(), sealed.data(), s_len - 1, dec.data(), n_threads));
+}
+
 }
@@ -0,0 +1,162 @@
+#pragma once
+#include "parallel.hpp"
+#include "xoodyak.hpp"
+#include <algorithm>
+#include <vector>
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Message is split into leaves of this many bytes ( last one can be shorter ),
+// each of them hashed independently, by `tree_hash(...)`
+constexpr size_t TREE_LEAF_LEN = 8192ul;
+
+namespace tree {
+
+// Domain seperators, absorbed ( as separate Cyclist `Absorb()` call ) after
+// content of leaf/ final node, so that neither of them can be confused with
+// each other or with plain `hash(...)`, which makes single `Absorb()` call
+constexpr uint8_t LEAF_SUFFIX = 0x00u;
+constexpr uint8_t FINAL_SUFFIX = 0x01u;
+
+// Computes 32 -bytes chaining values of N equal length leaves at once, using
+// multi-state Xoodoo permutation
+template<const size_t N>
+static inline void
+hash_leaves_xN(const uint8_t* const* const __restrict leaf,
+               const size_t l_len,
+               uint8_t* const* const __restrict cv)
+{
+  using cyclist::mode_t;
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(64) uint32_t state[12 * N]{};
+
+  // 1 -byte suffix lives in zero padded, rate sized buffer, so that word-wise
+  // block loads of absorb routine never read past it
+  alignas(16) const uint8_t suffix[cyclist::R_Hash]{ LEAF_SUFFIX };
+  const uint8_t* suffix_[N];
+  std::fill_n(suffix_, N, suffix);
+
+  cyclist::absorb_any_xN<N, mode_t::Hash, cyclist::R_Hash,
+                         cyclist::Absorb_Color_Hash>(state, leaf, l_len, &ph);
+  cyclist::absorb_any_xN<N, mode_t::Hash, cyclist::R_Hash,
+                         cyclist::Absorb_Color_Hash>(state, suffix_, 1, &ph);
+  cyclist::squeeze_any_xN<N, mode_t::Hash, cyclist::R_Hash,
+                          cyclist::Squeeze_Color>(state, cv, DIGEST_LEN, &ph);
+}
+
+// Computes 32 -bytes chaining value of a single leaf
+static inline void
+hash_leaf(const uint8_t* const __restrict leaf,
+          const size_t l_len,
+          uint8_t* const __restrict cv)
+{
+  using cyclist::mode_t;
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  // see `hash_leaves_xN(...)`, for why suffix is zero padded
+  alignas(16) const uint8_t suffix[cyclist::R_Hash]{ LEAF_SUFFIX };
+
+  cyclist::absorb<mode_t::Hash>(state, leaf, l_len, &ph);
+  cyclist::absorb<mode_t::Hash>(state, suffix, 1, &ph);
+  cyclist::squeeze<mode_t::Hash>(state, cv, DIGEST_LEN, &ph);
+}
+
+// Computes chaining values of all leaves, in [from, to), where full leaves are
+// hashed in groups of N, while remaining ones are hashed one at a time
+template<const size_t N>
+static inline void
+hash_leaves(const uint8_t* const __restrict msg,
+            const size_t m_len,
+            const size_t from,
+            const size_t to,
+            uint8_t* const __restrict cvs)
+{
+  size_t i = from;
+  while (i < to) {
+    const bool full_group = (i + N <= to) && ((i + N) * TREE_LEAF_LEN <= m_len);
+
+    if (full_group) {
+      const uint8_t* leaf[N];
+      uint8_t* cv[N];
+
+      for (size_t j = 0; j < N; j++) {
+        leaf[j] = msg + (i + j) * TREE_LEAF_LEN;
+        cv[j] = cvs + (i + j) * DIGEST_LEN;
+      }
+
+      hash_leaves_xN<N>(leaf, TREE_LEAF_LEN, cv);
+      i += N;
+    } else {
+      const size_t off = i * TREE_LEAF_LEN;
+      const size_t len = std::min(TREE_LEAF_LEN, m_len - off);
+
+      hash_leaf(msg + off, len, cvs + i * DIGEST_LEN);
+      i += 1;
+    }
+  }
+}
+
+}
+
+// Xoodyak based parallel tree hash function, which splits N -bytes message into
+// `TREE_LEAF_LEN` -bytes leaves ( last one can be shorter; empty message forms
+// single empty leaf ), computes 32 -bytes chaining value of each leaf, on
+// `n_threads` worker threads ( 0 denotes all available hardware threads ),
+// each of them hashing multiple leaves at once, using multi-state Xoodoo
+// permutation. Finally chaining values are hashed together, into 32 -bytes
+// digest.
+//
+// Leaf i.e. `Absorb(leaf) -> Absorb(0x00) -> Squeeze(32)`
+// Final node i.e. `Absorb(cv_0 || ... || cv_{n-1}) -> Absorb(le64(n) ||
+// le64(TREE_LEAF_LEN) || 0x01) -> Squeeze(32)`
+//
+// Note, this is a different function than NIST specified Xoodyak `hash(...)`,
+// so digests computed by them are never same, for same message. Digest doesn't
+// depend on number of threads used.
+static inline void
+tree_hash(const uint8_t* const __restrict msg, // N (>=0) -bytes message
+          const size_t m_len,                  // len(msg)
+          uint8_t* const __restrict out,       // 32 -bytes digest
+          const size_t n_threads = 0ul         // # -of worker threads
+)
+{
+  using cyclist::mode_t;
+
+  const size_t leaves =
+    std::max<size_t>(1, (m_len + TREE_LEAF_LEN - 1) / TREE_LEAF_LEN);
+  std::vector<uint8_t> cvs(leaves * DIGEST_LEN);
+
+  const bool wide = xoodoo::active_isa() >= xoodoo::isa_t::avx512;
+  const size_t group = wide ? 16 : 8;
+
+  auto work = [&](const size_t from, const size_t to) {
+    if (wide) {
+      tree::hash_leaves<16>(msg, m_len, from, to, cvs.data());
+    } else {
+      tree::hash_leaves<8>(msg, m_len, from, to, cvs.data());
+    }
+  };
+
+  xoodyak_utils::parallel_for(leaves, group, n_threads, work);
+
+  uint8_t suffix[17];
+  for (size_t i = 0; i < 8; i++) {
+    suffix[i] = static_cast<uint8_t>(leaves >> (i << 3));
+    suffix[8 + i] = static_cast<uint8_t>(TREE_LEAF_LEN >> (i << 3));
+  }
+  suffix[16] = tree::FINAL_SUFFIX;
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  cyclist::absorb<mode_t::Hash>(state, cvs.data(), cvs.size(), &ph);
+  cyclist::absorb<mode_t::Hash>(state, suffix, sizeof(suffix), &ph);
+  cyclist::squeeze<mode_t::Hash>(state, out, DIGEST_LEN, &ph);
+}
+
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include "xoodyak.hpp"
+
+// Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
+// Associated Data ( read AEAD ) scheme
+namespace xoodyak {
+
+// Xoodyak extendable output function ( read XOF ), which can consume message
+// arriving in arbitrary sized chunks, by calling `absorb(...)` as many times as
+// needed, before squeezing arbitrary many output bytes, in arbitrary sized
+// chunks, by calling `squeeze(...)` as many times as needed.
+//
+// Output stream is same as Cyclist `Squeeze(ℓ)` ( in hashing mode ) produces,
+// after absorbing all chunks, concatenated, for ℓ = total number of bytes
+// squeezed, so first 32 -bytes of it is same as `hash(...)` digest. Output
+// block, which is partially squeezed, stays in permutation state, so nothing is
+// ever recomputed.
+//
+// See section 1.3.1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+struct xof_t
+{
+private:
+  alignas(16) uint32_t state[12]{};
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+
+  // partially filled message block, waiting for more bytes
+  uint8_t buf[cyclist::R_Hash]{};
+  size_t buf_len = 0ul;
+
+  // how many message blocks are already absorbed into permutation state
+  size_t blk_cnt = 0ul;
+  bool squeezing = false;
+
+  // how many bytes of current output block are already squeezed
+  size_t sq_off = 0ul;
+
+  // Absorbs single message block ( of length <= `R_Hash` ) into permutation
+  // state, following `absorb_any(...)` routine of Cyclist mode of operation,
+  // where only the first block is absorbed with domain seperator color
+  inline void absorb_block(const uint8_t* const blk, const size_t b_len)
+  {
+    using cyclist::mode_t;
+
+    if (blk_cnt == 0ul) {
+      cyclist::down<mode_t::Hash, cyclist::Absorb_Color_Hash>(
+        state, blk, b_len, &ph);
+    } else {
+      cyclist::up<mode_t::Hash, cyclist::Zero_Color>(state, nullptr, 0ul, &ph);
+      cyclist::down<mode_t::Hash, cyclist::Zero_Color>(state, blk, b_len, &ph);
+    }
+
+    blk_cnt++;
+  }
+
+public:
+  inline xof_t() = default;
+
+  // Given N (>=0) -bytes message chunk, this routine absorbs all full message
+  // blocks into permutation state, while buffering remaining bytes, until next
+  // call to `absorb(...)` or `squeeze(...)`.
+  //
+  // Once `squeeze(...)` is called, calling this routine doesn't do anything.
+  inline void absorb(const uint8_t* const __restrict msg, const size_t m_len)
+  {
+    if (squeezing) {
+      return;
+    }
+
+    constexpr size_t rate = cyclist::R_Hash;
+
+    size_t off = 0ul;
+    while (off < m_len) {
+      // full blocks are absorbed directly from input, without buffering
+      if ((buf_len == 0ul) && ((m_len - off) >= rate)) {
+        absorb_block(msg + off, rate);
+        off += rate;
+
+        continue;
+      }
+
+      const size_t read = std::min(rate - buf_len, m_len - off);
+      std::memcpy(buf + buf_len, msg + off, read);
+
+      buf_len += read;
+      off += read;
+
+      if (buf_len == rate) {
+        absorb_block(buf, rate);
+        buf_len = 0ul;
+      }
+    }
+  }
+
+  // Squeezes next N (>=0) -bytes of output stream, out of permutation state.
+  // First call absorbs remaining buffered message bytes ( if any ), after which
+  // message can't be absorbed anymore.
+  inline void squeeze(uint8_t* const __restrict out, const size_t o_len)
+  {
+    using cyclist::mode_t;
+    constexpr size_t rate = cyclist::R_Hash;
+
+    if (!squeezing) {
+      // empty message is absorbed as single empty block
+      if ((buf_len > 0ul) || (blk_cnt == 0ul)) {
+        absorb_block(buf, buf_len);
+        buf_len = 0ul;
+      }
+
+      cyclist::up<mode_t::Hash, cyclist::Squeeze_Color>(
+        state, nullptr, 0ul, &ph);
+
+      squeezing = true;
+      sq_off = 0ul;
+    }
+
+    size_t off = 0ul;
+    while (off < o_len) {
+      if (sq_off == rate) {
+        cyclist::down<mode_t::Hash, cyclist::Zero_Color>(
+          state, nullptr, 0ul, &ph);
+
+        // full blocks are squeezed directly into output
+        if ((o_len - off) >= rate) {
+          cyclist::up<mode_t::Hash, cyclist::Zero_Color>(
+            state, out + off, rate, &ph);
+          off += rate;
+
+          continue;
+        }
+
+        cyclist::up<mode_t::Hash, cyclist::Zero_Color>(
+          state, nullptr, 0ul, &ph);
+        sq_off = 0ul;
+      }
+
+      const size_t read = std::min(rate - sq_off, o_len - off);
+      for (size_t i = 0; i < read; i++) {
+        out[off + i] = cyclist::get_byte(state, sq_off + i);
+      }
+
+      sq_off += read;
+      off += read;
+    }
+  }
+
+  // Resets XOF to its initial state, so that it can be used for another message.
+  inline void reset()
+  {
+    std::memset(state, 0, sizeof(state));
+    std::memset(buf, 0, sizeof(buf));
+
+    ph = cyclist::phase_t::Up;
+    buf_len = 0ul;
+    blk_cnt = 0ul;
+    squeezing = false;
+    sq_off = 0ul;
+  }
+};
+
+// Xoodyak extendable output function, which given N -bytes message, computes M
+// -bytes output, same as `Absorb(msg) -> Squeeze(M)` of Cyclist hashing mode.
+static inline void
+xof(const uint8_t* const __restrict msg, // N (>=0) -bytes message
+    const size_t m_len,                  // len(msg)
+    uint8_t* const __restrict out,       // M (>=0) -bytes output
+    const size_t o_len                   // len(out)
+)
+{
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  cyclist::absorb<cyclist::mode_t::Hash>(state, msg, m_len, &ph);
+  cyclist::squeeze<cyclist::mode_t::Hash>(state, out, o_len, &ph);
+}
+
+}
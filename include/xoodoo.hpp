@@ -1,15 +1,36 @@
 #pragma once
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 
-#if defined __SSE2__ && USE_SSE2 != 0
-// SSE intrinsics are defined on
-// https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html#techs=SSE_ALL
-#include <emmintrin.h>
-#pragma message("Using SSE2 for Xoodoo[12] Permutation")
+#if (defined __x86_64__ || defined __i386__) && defined __GNUC__
+// On x86 targets, SIMD implementations of Xoodoo permutation are compiled in,
+// irrespective of target CPU flags passed to compiler, by marking each of them
+// with appropriate `target` function attribute, while one of them is chosen at
+// run-time, based on CPU features; see `permute(...)`
+//
+// Intrinsics are defined on
+// https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+#include <immintrin.h>
+#define XOODOO_X86 1
+#define XOODOO_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if defined __GNUC__
+// Template recursion, unrolling Xoodoo rounds at compile-time, is forcefully
+// inlined into permutation routines, so that it never survives as a chain of
+// function calls, passing state through memory
+#define XOODOO_UNROLLED __attribute__((always_inline))
+// Rounds themselves aren't forcefully inlined ( see `cyclist_reg.hpp` ), so
+// permutation routines inline everything they call, no matter how large the
+// translation unit including them grows
+#define XOODOO_FLATTEN __attribute__((flatten))
+#else
+#define XOODOO_UNROLLED
+#define XOODOO_FLATTEN
 #endif
 
 // Xoodoo permutation which empowers Xoodyak cryptographic suite !
@@ -33,56 +54,33 @@ check_lane_shift_factor(const int t)
   return (t == 0) || (t == 1) || (t == 2);
 }
 
-#if defined __SSE2__ && USE_SSE2 != 0
-
-// Given a 128 -bit wide plane of Xoodoo permutation state ( each plane has 4
-// lanes, each lane of 32 -bit ), this function cyclically shifts the plane such
-// that bit at position (x, z) moves to (x+t, z+v), using SSE2 intrinsics.
-//
-// Note, at z = 0 bit index, least significant bit of each lane lives !
+// Compile-time check to ensure that number of rounds ∈ [1, 12], for reduced
+// round Xoodoo[n] permutation, which applies last n rounds of Xoodoo[12] i.e.
+// round constants RC[12 - n], ..., RC[11]
 //
-// See row 2 of table 1 in Xoodyak specification
+// See section 2.1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-//
-// Find more about SSE intrinsics here
-// https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html#techs=SSE_ALL
-template<const int t, const int v>
-static inline __m128i
-cyclic_shift(const __m128i plane)
-  requires(check_lane_shift_factor(t))
+consteval bool
+check_rounds(const size_t n_rounds)
 {
-  static_assert(v < 32, "Can't rotate 32 -bit integer by more than 31 -bits");
-
-  if constexpr (t == 0) {
-    // force compile-time branch evaluation
-    static_assert(t == 0, "t must be = 0");
-
-    const auto shl = _mm_slli_epi32(plane, v);
-    const auto shr = _mm_srli_epi32(plane, 32 - v);
-
-    return _mm_xor_si128(shl, shr);
-  } else if constexpr (t == 1) {
-    // force compile-time branch evaluation
-    static_assert(t == 1, "t must be = 1");
-
-    const auto shl = _mm_slli_epi32(plane, v);
-    const auto shr = _mm_srli_epi32(plane, 32 - v);
-    const auto rot = _mm_xor_si128(shl, shr);
-
-    return _mm_shuffle_epi32(rot, 0b10010011);
-  } else {
-    // force compile-time branch evaluation
-    static_assert(t == 2, "t must be = 2");
-
-    const auto shl = _mm_slli_epi32(plane, v);
-    const auto shr = _mm_srli_epi32(plane, 32 - v);
-    const auto rot = _mm_xor_si128(shl, shr);
-
-    return _mm_shuffle_epi32(rot, 0b01001110);
-  }
+  return (n_rounds > 0) && (n_rounds <= ROUNDS);
 }
 
-#else
+// Instruction set extensions, for which some implementation of Xoodoo
+// permutation ( or of its multi-state variant ) exists, in increasing order of
+// preference
+enum class isa_t : uint8_t
+{
+  scalar, // portable C++
+  sse2,   // 128 -bit SSE2
+  ssse3,  // 128 -bit SSE2 + byte shuffle of SSSE3
+  avx2,   // 256 -bit AVX2, used for multi-state permutation
+  avx512  // 512 -bit AVX-512F ( + AVX-512VL for 128 -bit registers )
+};
+
+// Portable implementation of Xoodoo permutation, which can also be evaluated at
+// compile-time, as all of its routines are `constexpr`
+namespace scalar {
 
 // Given a plane of Xoodoo permutation state ( each plane has 4 lanes, each lane
 // of 32 -bit ), this function cyclically shifts the plane such that bit at
@@ -93,7 +91,7 @@ cyclic_shift(const __m128i plane)
 // See row 2 of table 1 in Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
 template<const int t, const int v>
-static inline void
+static inline constexpr void
 cyclic_shift(uint32_t* const plane)
   requires((check_lane_shift_factor(t)))
 {
@@ -159,36 +157,10 @@ cyclic_shift(uint32_t* const plane)
   }
 }
 
-#endif
-
-#if defined __SSE2__ && USE_SSE2 != 0
-
-// θ step mapping of Xoodoo permutation, as described in algorithm 1 of Xoodyak
-// specification
-// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-// implemented using SSE2 intrinsics s.t. whole state is represented using three
-// 128 -bit SSE register.
-static inline std::array<__m128i, 3>
-theta(const std::array<__m128i, 3> state)
-{
-  const auto t0 = _mm_xor_si128(state[0], state[1]);
-  const auto t1 = _mm_xor_si128(t0, state[2]);
-
-  const auto p0 = cyclic_shift<1, 5>(t1);
-  const auto p1 = cyclic_shift<1, 14>(t1);
-  const auto e = _mm_xor_si128(p0, p1);
-
-  return { _mm_xor_si128(state[0], e),
-           _mm_xor_si128(state[1], e),
-           _mm_xor_si128(state[2], e) };
-}
-
-#else
-
 // θ step mapping of Xoodoo permutation, as described in algorithm 1 of Xoodyak
 // specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-static inline void
+static inline constexpr void
 theta(uint32_t* const state)
 {
   uint32_t p0[4]{}; // must be zero-initialized !
@@ -215,7 +187,7 @@ theta(uint32_t* const state)
     p0[3] ^= state[i + 3];
   }
 
-  std::memcpy(p1, p0, sizeof(p0));
+  std::copy_n(p0, 4, p1);
 
   cyclic_shift<1, 5>(p0);
   cyclic_shift<1, 14>(p1);
@@ -258,105 +230,37 @@ theta(uint32_t* const state)
   }
 }
 
-#endif
-
-#if defined __SSE2__ && USE_SSE2 != 0
-
-// ρ step mapping function of Xoodoo permutation, which is templated so that it
-// can act as both `ρ_east` and `ρ_west`, implemented using SSE2 vector
-// intrinsics.
-//
-// See algorithm 1 of Xoodyak specification
-// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-template<const size_t t1, const size_t v1, const size_t t2, const size_t v2>
-static inline std::array<__m128i, 3>
-rho(const std::array<__m128i, 3> state)
-{
-  return { state[0],
-           cyclic_shift<t1, v1>(state[1]),
-           cyclic_shift<t2, v2>(state[2]) };
-}
-
-#else
-
 // ρ step mapping function of Xoodoo permutation, which is templated so that it
 // can act as both `ρ_east` and `ρ_west`
 //
 // See algorithm 1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
 template<const size_t t1, const size_t v1, const size_t t2, const size_t v2>
-static inline void
+static inline constexpr void
 rho(uint32_t* const state)
 {
   cyclic_shift<t1, v1>(state + 4);
   cyclic_shift<t2, v2>(state + 8);
 }
 
-#endif
-
-#if defined __SSE2__ && USE_SSE2 != 0
-
-// ι step mapping function of Xoodoo permutation, where single round constant is
-// XORed into first lane ( x = 0 ) of first plane ( y = 0 ) of internal state,
-// using SSE2 intrinsics.
-//
-// See algorithm 1 of Xoodyak specification
-// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-static inline __m128i
-iota(const __m128i plane, const size_t r_idx)
-{
-  // Attempting to load from memory address aligned to 16 -bytes boundary, see
-  // https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html#techs=SSE_ALL&cats=Load&text=_mm_load_si128&ig_expand=4428
-  alignas(16) const uint32_t tmp[4]{ RC[r_idx], 0u, 0u, 0u };
-  const auto rc = _mm_load_si128((__m128i*)tmp);
-
-  return _mm_xor_si128(plane, rc);
-}
-
-#else
-
 // ι step mapping function of Xoodoo permutation, where round constant is XORed
 // into first lane ( x = 0 ) of first plane ( y = 0 ) of internal state
 //
 // See algorithm 1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-static inline void
-iota(uint32_t* const state, const size_t r_idx)
+template<const size_t r_idx>
+static inline constexpr void
+iota(uint32_t* const state)
 {
   state[0] ^= RC[r_idx];
 }
 
-#endif
-
-#if defined __SSE2__ && USE_SSE2 != 0
-
-// χ step mapping function of Xoodoo permutation, which is a non-linear layer
-// applied on state during permutation round, using SSE2 vector intrinsics.
-//
-// See algorithm 1 of Xoodyak specification
-// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-static inline std::array<__m128i, 3>
-chi(const std::array<__m128i, 3> state)
-{
-  const auto b0 = _mm_andnot_si128(state[1], state[2]);
-  const auto b1 = _mm_andnot_si128(state[2], state[0]);
-  const auto b2 = _mm_andnot_si128(state[0], state[1]);
-
-  return {
-    _mm_xor_si128(state[0], b0),
-    _mm_xor_si128(state[1], b1),
-    _mm_xor_si128(state[2], b2),
-  };
-}
-
-#else
-
 // χ step mapping function of Xoodoo permutation, which is a non-linear layer
 // applied on state during permutation round
 //
 // See algorithm 1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
-static inline void
+static inline constexpr void
 chi(uint32_t* const state)
 {
   uint32_t b0[4];
@@ -434,10 +338,6 @@ chi(uint32_t* const state)
   }
 }
 
-#endif
-
-#if defined __SSE2__ && USE_SSE2 != 0
-
 // Single round ( which specific round it is, denoted by `r_idx` ∈ [0, 12) ) of
 // Xoodoo permutation, which applies following step mappings on state, in order
 //
@@ -447,23 +347,189 @@ chi(uint32_t* const state)
 // - non-linear layer χ
 // - plane shifting ρ_east
 //
-// using SSE2 intrinsics.
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t r_idx>
+static inline constexpr void
+round(uint32_t* const state)
+  requires(r_idx < ROUNDS)
+{
+  // mixing layer
+  theta(state);
+  // plane shifting
+  rho<1, 0, 0, 11>(state);
+  // add round constant
+  iota<r_idx>(state);
+  // non-linear layer
+  chi(state);
+  // plane shifting
+  rho<0, 1, 2, 8>(state);
+}
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on internal
+// state, unrolled at compile-time, using template recursion, so that each round
+// gets its round constant as an immediate operand
+template<const size_t r_idx>
+XOODOO_UNROLLED
+static inline constexpr void
+apply_rounds(uint32_t* const state)
+{
+  if constexpr (r_idx < ROUNDS) {
+    round<r_idx>(state);
+    apply_rounds<r_idx + 1>(state);
+  }
+}
+
+// Xoodoo[n] permutation function, where last n ( = 12, by default ) rounds of
+// Xoodoo round function are applied on internal state
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t n_rounds = ROUNDS>
+XOODOO_FLATTEN static inline constexpr void
+permute(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  apply_rounds<ROUNDS - n_rounds>(state);
+}
+
+}
+
+#if defined XOODOO_X86
+
+// Three 128 -bit planes of state are passed around as `std::array<__m128i, 3>`,
+// for which GCC warns that `may_alias` attribute of `__m128i` is dropped, as
+// it's used as template argument. Those arrays are never accessed through
+// pointers of other types, so the warning is silenced, for all SIMD
+// implementations below.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+
+// Implementation of Xoodoo permutation, where whole state is kept in three 128
+// -bit registers, using SSE2 intrinsics
+namespace sse2 {
+
+// Given a 128 -bit wide plane of Xoodoo permutation state ( each plane has 4
+// lanes, each lane of 32 -bit ), this function cyclically shifts the plane such
+// that bit at position (x, z) moves to (x+t, z+v), using SSE2 intrinsics.
+//
+// Note, at z = 0 bit index, least significant bit of each lane lives !
+//
+// See row 2 of table 1 in Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+//
+// Find more about SSE intrinsics here
+// https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html#techs=SSE_ALL
+template<const int t, const int v>
+XOODOO_TARGET("sse2")
+static inline __m128i
+cyclic_shift(const __m128i plane)
+  requires(check_lane_shift_factor(t))
+{
+  static_assert(v < 32, "Can't rotate 32 -bit integer by more than 31 -bits");
+
+  if constexpr (t == 0) {
+    // force compile-time branch evaluation
+    static_assert(t == 0, "t must be = 0");
+
+    const auto shl = _mm_slli_epi32(plane, v);
+    const auto shr = _mm_srli_epi32(plane, 32 - v);
+
+    return _mm_xor_si128(shl, shr);
+  } else if constexpr (t == 1) {
+    // force compile-time branch evaluation
+    static_assert(t == 1, "t must be = 1");
+
+    const auto shl = _mm_slli_epi32(plane, v);
+    const auto shr = _mm_srli_epi32(plane, 32 - v);
+    const auto rot = _mm_xor_si128(shl, shr);
+
+    return _mm_shuffle_epi32(rot, 0b10010011);
+  } else {
+    // force compile-time branch evaluation
+    static_assert(t == 2, "t must be = 2");
+
+    const auto shl = _mm_slli_epi32(plane, v);
+    const auto shr = _mm_srli_epi32(plane, 32 - v);
+    const auto rot = _mm_xor_si128(shl, shr);
+
+    return _mm_shuffle_epi32(rot, 0b01001110);
+  }
+}
+
+// θ step mapping of Xoodoo permutation, as described in algorithm 1 of Xoodyak
+// specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+// implemented using SSE2 intrinsics s.t. whole state is represented using three
+// 128 -bit SSE register.
+XOODOO_TARGET("sse2")
+static inline std::array<__m128i, 3>
+theta(const std::array<__m128i, 3> state)
+{
+  const auto t0 = _mm_xor_si128(state[0], state[1]);
+  const auto t1 = _mm_xor_si128(t0, state[2]);
+
+  const auto p0 = cyclic_shift<1, 5>(t1);
+  const auto p1 = cyclic_shift<1, 14>(t1);
+  const auto e = _mm_xor_si128(p0, p1);
+
+  return { _mm_xor_si128(state[0], e),
+           _mm_xor_si128(state[1], e),
+           _mm_xor_si128(state[2], e) };
+}
+
+// ρ step mapping function of Xoodoo permutation, which is templated so that it
+// can act as both `ρ_east` and `ρ_west`, implemented using SSE2 vector
+// intrinsics.
 //
 // See algorithm 1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t t1, const size_t v1, const size_t t2, const size_t v2>
+XOODOO_TARGET("sse2")
 static inline std::array<__m128i, 3>
-round(const std::array<__m128i, 3> state, const size_t r_idx)
+rho(const std::array<__m128i, 3> state)
 {
-  const auto t0 = theta(state);
-  const auto t1 = rho<1, 0, 0, 11>(t0);
-  const auto t2 = iota(t1[0], r_idx);
-  const auto t3 = chi({ t2, t1[1], t1[2] });
-  const auto t4 = rho<0, 1, 2, 8>(t3);
+  return { state[0],
+           cyclic_shift<t1, v1>(state[1]),
+           cyclic_shift<t2, v2>(state[2]) };
+}
 
-  return t4;
+// ι step mapping function of Xoodoo permutation, where single round constant is
+// XORed into first lane ( x = 0 ) of first plane ( y = 0 ) of internal state,
+// using SSE2 intrinsics.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t r_idx>
+XOODOO_TARGET("sse2")
+static inline __m128i
+iota(const __m128i plane)
+{
+  // round constant in lowest lane, while upper three lanes are zeroed
+  const auto rc = _mm_cvtsi32_si128(static_cast<int>(RC[r_idx]));
+
+  return _mm_xor_si128(plane, rc);
 }
 
-#else
+// χ step mapping function of Xoodoo permutation, which is a non-linear layer
+// applied on state during permutation round, using SSE2 vector intrinsics.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+XOODOO_TARGET("sse2")
+static inline std::array<__m128i, 3>
+chi(const std::array<__m128i, 3> state)
+{
+  const auto b0 = _mm_andnot_si128(state[1], state[2]);
+  const auto b1 = _mm_andnot_si128(state[2], state[0]);
+  const auto b2 = _mm_andnot_si128(state[0], state[1]);
+
+  return {
+    _mm_xor_si128(state[0], b0),
+    _mm_xor_si128(state[1], b1),
+    _mm_xor_si128(state[2], b2),
+  };
+}
 
 // Single round ( which specific round it is, denoted by `r_idx` ∈ [0, 12) ) of
 // Xoodoo permutation, which applies following step mappings on state, in order
@@ -474,63 +540,359 @@ round(const std::array<__m128i, 3> state, const size_t r_idx)
 // - non-linear layer χ
 // - plane shifting ρ_east
 //
+// using SSE2 intrinsics.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t r_idx>
+XOODOO_TARGET("sse2")
+static inline std::array<__m128i, 3>
+round(const std::array<__m128i, 3> state)
+  requires(r_idx < ROUNDS)
+{
+  const auto t0 = theta(state);
+  const auto t1 = rho<1, 0, 0, 11>(t0);
+  const auto t2 = iota<r_idx>(t1[0]);
+  const auto t3 = chi({ t2, t1[1], t1[2] });
+  const auto t4 = rho<0, 1, 2, 8>(t3);
+
+  return t4;
+}
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on internal
+// state, unrolled at compile-time, using template recursion, s.t. each round
+// gets its round constant as an immediate operand.
+template<const size_t r_idx>
+XOODOO_TARGET("sse2")
+XOODOO_UNROLLED
+static inline std::array<__m128i, 3>
+apply_rounds(const std::array<__m128i, 3> state)
+{
+  if constexpr (r_idx < ROUNDS) {
+    return apply_rounds<r_idx + 1>(round<r_idx>(state));
+  } else {
+    return state;
+  }
+}
+
+// Xoodoo[n] permutation function, where last n ( = 12, by default ) rounds of
+// Xoodoo round function are applied on internal state, using SSE2 intrinsics.
+//
 // See algorithm 1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t n_rounds = ROUNDS>
+XOODOO_TARGET("sse2")
+XOODOO_FLATTEN
 static inline void
-round(uint32_t* const state, const size_t r_idx)
+permute(uint32_t* const state)
+  requires(check_rounds(n_rounds))
 {
-  // mixing layer
-  theta(state);
-  // plane shifting
-  rho<1, 0, 0, 11>(state);
-  // add round constant
-  iota(state, r_idx);
-  // non-linear layer
-  chi(state);
-  // plane shifting
-  rho<0, 1, 2, 8>(state);
+  std::array<__m128i, 3> s_arr{ _mm_loadu_si128((const __m128i*)(state + 0)),
+                                _mm_loadu_si128((const __m128i*)(state + 4)),
+                                _mm_loadu_si128((const __m128i*)(state + 8)) };
+
+  s_arr = apply_rounds<ROUNDS - n_rounds>(s_arr);
+
+  _mm_storeu_si128((__m128i*)(state + 0), s_arr[0]);
+  _mm_storeu_si128((__m128i*)(state + 4), s_arr[1]);
+  _mm_storeu_si128((__m128i*)(state + 8), s_arr[2]);
 }
 
-#endif
+}
 
-#if defined __SSE2__ && USE_SSE2 != 0
+// Implementation of Xoodoo permutation, using SSE2 intrinsics, where SSSE3's
+// byte shuffle is used for performing plane shifting ρ_east on plane 2 ( which
+// rotates each lane by 8 -bits and also moves lanes along x -axis ) with single
+// instruction
+namespace ssse3 {
 
-// Xoodoo permutation function, where 12 rounds of Xoodoo round function is
-// applied on internal state, using SSE2 intrinsics.
+// ρ_east step mapping function of Xoodoo permutation, where plane 1 is shifted
+// by (0, 1) & plane 2 is shifted by (2, 8), using SSSE3 intrinsics
 //
 // See algorithm 1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+XOODOO_TARGET("ssse3")
+static inline std::array<__m128i, 3>
+rho_east(const std::array<__m128i, 3> state)
+{
+  // lane x ( of resulting plane ) = lane (x + 2) % 4 ( of input plane ),
+  // rotated leftwards by 8 -bits
+  const auto idx =
+    _mm_setr_epi8(11, 8, 9, 10, 15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6);
+
+  return { state[0],
+           sse2::cyclic_shift<0, 1>(state[1]),
+           _mm_shuffle_epi8(state[2], idx) };
+}
+
+// Single round ( which specific round it is, denoted by `r_idx` ∈ [0, 12) ) of
+// Xoodoo permutation, using SSE2 and SSSE3 intrinsics.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t r_idx>
+XOODOO_TARGET("ssse3")
+static inline std::array<__m128i, 3>
+round(const std::array<__m128i, 3> state)
+  requires(r_idx < ROUNDS)
+{
+  const auto t0 = sse2::theta(state);
+  const auto t1 = sse2::rho<1, 0, 0, 11>(t0);
+  const auto t2 = sse2::iota<r_idx>(t1[0]);
+  const auto t3 = sse2::chi({ t2, t1[1], t1[2] });
+  const auto t4 = rho_east(t3);
+
+  return t4;
+}
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on internal
+// state, unrolled at compile-time, using template recursion.
+template<const size_t r_idx>
+XOODOO_TARGET("ssse3")
+XOODOO_UNROLLED
+static inline std::array<__m128i, 3>
+apply_rounds(const std::array<__m128i, 3> state)
+{
+  if constexpr (r_idx < ROUNDS) {
+    return apply_rounds<r_idx + 1>(round<r_idx>(state));
+  } else {
+    return state;
+  }
+}
+
+// Xoodoo[n] permutation function, where last n ( = 12, by default ) rounds of
+// Xoodoo round function are applied on internal state, using SSE2 and SSSE3
+// intrinsics.
+template<const size_t n_rounds = ROUNDS>
+XOODOO_TARGET("ssse3")
+XOODOO_FLATTEN
 static inline void
 permute(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  std::array<__m128i, 3> s_arr{ _mm_loadu_si128((const __m128i*)(state + 0)),
+                                _mm_loadu_si128((const __m128i*)(state + 4)),
+                                _mm_loadu_si128((const __m128i*)(state + 8)) };
+
+  s_arr = apply_rounds<ROUNDS - n_rounds>(s_arr);
+
+  _mm_storeu_si128((__m128i*)(state + 0), s_arr[0]);
+  _mm_storeu_si128((__m128i*)(state + 4), s_arr[1]);
+  _mm_storeu_si128((__m128i*)(state + 8), s_arr[2]);
+}
+
+}
+
+// Implementation of Xoodoo permutation, where whole state is kept in three 128
+// -bit registers, using AVX-512VL intrinsics, s.t. lane rotations are native (
+// see `vprold` ), while three-input boolean functions of θ and χ are computed
+// with single ternary-logic instruction ( see `vpternlogd` ), where immediate
+// operand is truth table of function f(a, b, c), indexed by (a << 2) | (b << 1)
+// | c
+//
+// - 0x96 : a ^ b ^ c
+// - 0xd2 : a ^ (~b & c)
+namespace avx512 {
+
+// Given a 128 -bit wide plane of Xoodoo permutation state, this function
+// cyclically shifts the plane such that bit at position (x, z) moves to (x+t,
+// z+v), using AVX-512VL intrinsics.
+template<const int t, const int v>
+XOODOO_TARGET("avx512f,avx512vl")
+static inline __m128i
+cyclic_shift(const __m128i plane)
+  requires(check_lane_shift_factor(t))
 {
-  std::array<__m128i, 3> s_arr{ _mm_load_si128((__m128i*)(state + 0)),
-                                _mm_load_si128((__m128i*)(state + 4)),
-                                _mm_load_si128((__m128i*)(state + 8)) };
+  static_assert(v < 32, "Can't rotate 32 -bit integer by more than 31 -bits");
 
-  for (size_t i = 0; i < ROUNDS; i++) {
-    s_arr = round(s_arr, i);
+  __m128i rot = plane;
+  if constexpr (v > 0) {
+    rot = _mm_rol_epi32(plane, v);
   }
 
-  _mm_store_si128((__m128i*)(state + 0), s_arr[0]);
-  _mm_store_si128((__m128i*)(state + 4), s_arr[1]);
-  _mm_store_si128((__m128i*)(state + 8), s_arr[2]);
+  if constexpr (t == 0) {
+    return rot;
+  } else if constexpr (t == 1) {
+    return _mm_shuffle_epi32(rot, 0b10010011);
+  } else {
+    return _mm_shuffle_epi32(rot, 0b01001110);
+  }
 }
 
-#else
+// θ step mapping of Xoodoo permutation, using AVX-512VL intrinsics
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+XOODOO_TARGET("avx512f,avx512vl")
+static inline std::array<__m128i, 3>
+theta(const std::array<__m128i, 3> state)
+{
+  const auto p = _mm_ternarylogic_epi32(state[0], state[1], state[2], 0x96);
+  const auto p0 = cyclic_shift<1, 5>(p);
+  const auto p1 = cyclic_shift<1, 14>(p);
+
+  return { _mm_ternarylogic_epi32(state[0], p0, p1, 0x96),
+           _mm_ternarylogic_epi32(state[1], p0, p1, 0x96),
+           _mm_ternarylogic_epi32(state[2], p0, p1, 0x96) };
+}
 
-// Xoodoo permutation function, where 12 rounds of Xoodoo round function is
-// applied on internal state
+// χ step mapping function of Xoodoo permutation, using AVX-512VL intrinsics
 //
 // See algorithm 1 of Xoodyak specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+XOODOO_TARGET("avx512f,avx512vl")
+static inline std::array<__m128i, 3>
+chi(const std::array<__m128i, 3> state)
+{
+  return { _mm_ternarylogic_epi32(state[0], state[1], state[2], 0xd2),
+           _mm_ternarylogic_epi32(state[1], state[2], state[0], 0xd2),
+           _mm_ternarylogic_epi32(state[2], state[0], state[1], 0xd2) };
+}
+
+// Single round ( which specific round it is, denoted by `r_idx` ∈ [0, 12) ) of
+// Xoodoo permutation, using AVX-512VL intrinsics.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t r_idx>
+XOODOO_TARGET("avx512f,avx512vl")
+static inline std::array<__m128i, 3>
+round(const std::array<__m128i, 3> state)
+  requires(r_idx < ROUNDS)
+{
+  const auto t0 = theta(state);
+  const std::array<__m128i, 3> t1{ t0[0],
+                                   cyclic_shift<1, 0>(t0[1]),
+                                   cyclic_shift<0, 11>(t0[2]) };
+  const auto t2 = sse2::iota<r_idx>(t1[0]);
+  const auto t3 = chi({ t2, t1[1], t1[2] });
+  const std::array<__m128i, 3> t4{ t3[0],
+                                   cyclic_shift<0, 1>(t3[1]),
+                                   cyclic_shift<2, 8>(t3[2]) };
+
+  return t4;
+}
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on internal
+// state, unrolled at compile-time, using template recursion.
+template<const size_t r_idx>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_UNROLLED
+static inline std::array<__m128i, 3>
+apply_rounds(const std::array<__m128i, 3> state)
+{
+  if constexpr (r_idx < ROUNDS) {
+    return apply_rounds<r_idx + 1>(round<r_idx>(state));
+  } else {
+    return state;
+  }
+}
+
+// Xoodoo[n] permutation function, where last n ( = 12, by default ) rounds of
+// Xoodoo round function are applied on internal state, using AVX-512VL
+// intrinsics.
+template<const size_t n_rounds = ROUNDS>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
 static inline void
 permute(uint32_t* const state)
+  requires(check_rounds(n_rounds))
 {
-  for (size_t i = 0; i < ROUNDS; i++) {
-    round(state, i);
+  std::array<__m128i, 3> s_arr{ _mm_loadu_si128((const __m128i*)(state + 0)),
+                                _mm_loadu_si128((const __m128i*)(state + 4)),
+                                _mm_loadu_si128((const __m128i*)(state + 8)) };
+
+  s_arr = apply_rounds<ROUNDS - n_rounds>(s_arr);
+
+  _mm_storeu_si128((__m128i*)(state + 0), s_arr[0]);
+  _mm_storeu_si128((__m128i*)(state + 4), s_arr[1]);
+  _mm_storeu_si128((__m128i*)(state + 8), s_arr[2]);
+}
+
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+// Probes CPU features ( using CPUID ), returning widest instruction set
+// extension, for which some Xoodoo permutation implementation exists
+inline isa_t
+detect_isa()
+{
+#if defined XOODOO_X86
+  // must be called before `__builtin_cpu_supports(...)`, in case this routine
+  // runs before constructors of GCC runtime library
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")) {
+    return isa_t::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return isa_t::avx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return isa_t::ssse3;
   }
+  if (__builtin_cpu_supports("sse2")) {
+    return isa_t::sse2;
+  }
+#endif
+
+  return isa_t::scalar;
+}
+
+// Widest instruction set extension, supported by executing CPU, which is probed
+// only once, on first call, while later calls return cached result
+inline isa_t
+active_isa()
+{
+  static const isa_t isa = detect_isa();
+  return isa;
 }
 
+// Signature of routine applying Xoodoo permutation on single state
+using permute_fn_t = void (*)(uint32_t* const);
+
+// Given an instruction set extension, this routine returns Xoodoo[n] ( = 12, by
+// default ) permutation implementation best suited for it. Note, AVX2 doesn't
+// bring anything for 128 -bit wide state, so SSSE3 implementation is used on
+// such CPUs.
+//
+// It's caller's responsibility to ensure that executing CPU supports `isa`.
+template<const size_t n_rounds = ROUNDS>
+static inline permute_fn_t
+permute_kernel(const isa_t isa)
+  requires(check_rounds(n_rounds))
+{
+  switch (isa) {
+#if defined XOODOO_X86
+    case isa_t::avx512:
+      return avx512::permute<n_rounds>;
+    case isa_t::avx2:
+    case isa_t::ssse3:
+      return ssse3::permute<n_rounds>;
+    case isa_t::sse2:
+      return sse2::permute<n_rounds>;
 #endif
+    default:
+      return scalar::permute<n_rounds>;
+  }
+}
+
+// Xoodoo[n] permutation function, where last n ( = 12, by default ) rounds of
+// Xoodoo round function are applied on internal state, using best
+// implementation available on executing CPU, which is chosen on first call.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t n_rounds = ROUNDS>
+static inline void
+permute(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  static const permute_fn_t fn = permute_kernel<n_rounds>(active_isa());
+  fn(state);
+}
 
 }
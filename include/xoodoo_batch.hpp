@@ -0,0 +1,603 @@
+#pragma once
+#include "xoodoo.hpp"
+
+// Multi-state Xoodoo permutation, applying Xoodoo[12] ( or reduced round
+// Xoodoo[n] ) on N independent states at once, so that batches of independent
+// messages can be hashed/ encrypted together.
+//
+// All routines in this namespace operate on lane-transposed states i.e. given
+// N states, each of 12 lanes, they are laid out as 12 rows of N words s.t. lane
+// `i` of state `j` lives at index `i * N + j`. That way each row can be held in
+// a single SIMD register, while plane shifting ( read ρ_west, ρ_east ) becomes
+// free register renaming.
+//
+// N = 8 maps onto AVX2, while N = 16 maps onto AVX-512 ( or two interleaved
+// AVX2 halves ), when executing CPU supports them, falling back to portable
+// implementation otherwise.
+namespace xoodoo {
+
+// Given N lane-transposed Xoodoo states, this routine applies single round (
+// denoted by `r_idx` ∈ [0, 12) ) of Xoodoo permutation on each of them, written
+// in portable C++ so that compiler can auto-vectorize it for any N.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t N, const size_t r_idx>
+XOODOO_UNROLLED
+static inline void
+round_xN(uint32_t* const state)
+  requires(r_idx < ROUNDS)
+{
+  uint32_t* const a0 = state;
+  uint32_t* const a1 = state + 4 * N;
+  uint32_t* const a2 = state + 8 * N;
+
+  uint32_t p[4 * N];
+  uint32_t e[4 * N];
+
+  // mixing layer θ
+  for (size_t i = 0; i < 4 * N; i++) {
+    p[i] = a0[i] ^ a1[i] ^ a2[i];
+  }
+
+  for (size_t x = 0; x < 4; x++) {
+    const uint32_t* const p_ = p + ((x + 3) & 3) * N;
+
+    for (size_t j = 0; j < N; j++) {
+      e[x * N + j] = std::rotl(p_[j], 5) ^ std::rotl(p_[j], 14);
+    }
+  }
+
+  for (size_t i = 0; i < 4 * N; i++) {
+    a0[i] ^= e[i];
+    a1[i] ^= e[i];
+    a2[i] ^= e[i];
+  }
+
+  // plane shifting ρ_west, where plane 1 is shifted by (1, 0) & plane 2 is
+  // shifted by (0, 11)
+  std::memcpy(p, a1, sizeof(p));
+  std::memcpy(a1 + N, p, sizeof(p) - N * sizeof(uint32_t));
+  std::memcpy(a1, p + 3 * N, N * sizeof(uint32_t));
+
+  for (size_t i = 0; i < 4 * N; i++) {
+    a2[i] = std::rotl(a2[i], 11);
+  }
+
+  // addition of round constant ι
+  for (size_t j = 0; j < N; j++) {
+    a0[j] ^= RC[r_idx];
+  }
+
+  // non-linear layer χ
+  for (size_t i = 0; i < 4 * N; i++) {
+    const uint32_t b0 = ~a1[i] & a2[i];
+    const uint32_t b1 = ~a2[i] & a0[i];
+    const uint32_t b2 = ~a0[i] & a1[i];
+
+    a0[i] ^= b0;
+    a1[i] ^= b1;
+    a2[i] ^= b2;
+  }
+
+  // plane shifting ρ_east, where plane 1 is shifted by (0, 1) & plane 2 is
+  // shifted by (2, 8)
+  for (size_t i = 0; i < 4 * N; i++) {
+    a1[i] = std::rotl(a1[i], 1);
+  }
+
+  std::memcpy(p, a2, sizeof(p));
+  for (size_t i = 0; i < 4 * N; i++) {
+    a2[i] = std::rotl(p[(i + 2 * N) % (4 * N)], 8);
+  }
+}
+
+// Given N lane-transposed Xoodoo states, this routine applies rounds r_idx,
+// r_idx + 1, ..., 11 of Xoodoo permutation on each of them, unrolled at
+// compile-time, using template recursion.
+template<const size_t N, const size_t r_idx>
+XOODOO_UNROLLED
+static inline void
+apply_rounds_xN(uint32_t* const state)
+{
+  if constexpr (r_idx < ROUNDS) {
+    round_xN<N, r_idx>(state);
+    apply_rounds_xN<N, r_idx + 1>(state);
+  }
+}
+
+// Given N lane-transposed Xoodoo states, this routine applies Xoodoo[n] ( = 12,
+// by default ) permutation on each of them, using portable C++.
+template<const size_t N, const size_t n_rounds = ROUNDS>
+XOODOO_FLATTEN static inline void
+permute_xN(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  apply_rounds_xN<N, ROUNDS - n_rounds>(state);
+}
+
+#if defined XOODOO_X86
+
+// Multi-state Xoodoo permutation, using AVX2 intrinsics
+namespace avx2 {
+
+// Given a 256 -bit AVX2 register holding 8 lanes ( each of 32 -bit ), this
+// function rotates each lane leftwards by v -bits. Rotation by 8 -bits is a
+// pure byte permutation, so it's done with single byte shuffle instruction.
+template<const int v>
+XOODOO_TARGET("avx2")
+static inline __m256i
+rotl_x8(const __m256i lanes)
+{
+  static_assert(v > 0 && v < 32, "Can't rotate 32 -bit integer by ∉ [1, 32)");
+
+  if constexpr (v == 8) {
+    const auto idx = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10,
+                                      15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6,
+                                      11, 8, 9, 10, 15, 12, 13, 14);
+    return _mm256_shuffle_epi8(lanes, idx);
+  } else {
+    const auto shl = _mm256_slli_epi32(lanes, v);
+    const auto shr = _mm256_srli_epi32(lanes, 32 - v);
+
+    return _mm256_or_si256(shl, shr);
+  }
+}
+
+// Single round ( which specific round it is, denoted by `r_idx` ∈ [0, 12) ) of
+// Xoodoo permutation, applied on 8 lane-transposed states at once, s.t. each
+// row of states is kept in one 256 -bit AVX2 register.
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t r_idx>
+XOODOO_TARGET("avx2")
+XOODOO_UNROLLED
+static inline void
+round_x8(__m256i* const s)
+  requires(r_idx < ROUNDS)
+{
+  // mixing layer θ, where column parity of x -th column is computed just
+  // before that column is modified, so that at most two column parities are
+  // live at any moment, keeping register pressure low
+  auto p_prev = _mm256_xor_si256(_mm256_xor_si256(s[3], s[7]), s[11]);
+  for (size_t x = 0; x < 4; x++) {
+    const auto p = _mm256_xor_si256(_mm256_xor_si256(s[x], s[4 + x]), s[8 + x]);
+    const auto e = _mm256_xor_si256(rotl_x8<5>(p_prev), rotl_x8<14>(p_prev));
+
+    s[x] = _mm256_xor_si256(s[x], e);
+    s[4 + x] = _mm256_xor_si256(s[4 + x], e);
+    s[8 + x] = _mm256_xor_si256(s[8 + x], e);
+
+    p_prev = p;
+  }
+
+  // plane shifting ρ_west
+  const auto t = s[7];
+  s[7] = s[6];
+  s[6] = s[5];
+  s[5] = s[4];
+  s[4] = t;
+
+  for (size_t x = 0; x < 4; x++) {
+    s[8 + x] = rotl_x8<11>(s[8 + x]);
+  }
+
+  // addition of round constant ι
+  s[0] = _mm256_xor_si256(s[0], _mm256_set1_epi32(RC[r_idx]));
+
+  // non-linear layer χ
+  for (size_t x = 0; x < 4; x++) {
+    const auto b0 = _mm256_andnot_si256(s[4 + x], s[8 + x]);
+    const auto b1 = _mm256_andnot_si256(s[8 + x], s[x]);
+    const auto b2 = _mm256_andnot_si256(s[x], s[4 + x]);
+
+    s[x] = _mm256_xor_si256(s[x], b0);
+    s[4 + x] = _mm256_xor_si256(s[4 + x], b1);
+    s[8 + x] = _mm256_xor_si256(s[8 + x], b2);
+  }
+
+  // plane shifting ρ_east
+  for (size_t x = 0; x < 4; x++) {
+    s[4 + x] = rotl_x8<1>(s[4 + x]);
+  }
+
+  const auto t0 = rotl_x8<8>(s[10]);
+  const auto t1 = rotl_x8<8>(s[11]);
+  s[10] = rotl_x8<8>(s[8]);
+  s[11] = rotl_x8<8>(s[9]);
+  s[8] = t0;
+  s[9] = t1;
+}
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on 8 ( or 16,
+// when both halves are given ) lane-transposed states, unrolled at
+// compile-time, using template recursion, where two halves are permuted in
+// interleaved fashion.
+template<const size_t r_idx>
+XOODOO_TARGET("avx2")
+XOODOO_UNROLLED
+static inline void
+apply_rounds_x8(__m256i* const s_lo, __m256i* const s_hi = nullptr)
+{
+  if constexpr (r_idx < ROUNDS) {
+    round_x8<r_idx>(s_lo);
+    if (s_hi != nullptr) {
+      round_x8<r_idx>(s_hi);
+    }
+
+    apply_rounds_x8<r_idx + 1>(s_lo, s_hi);
+  }
+}
+
+// Xoodoo[n] ( = 12, by default ) permutation, applied on 8 lane-transposed
+// states at once, using AVX2 intrinsics.
+template<const size_t n_rounds = ROUNDS>
+XOODOO_TARGET("avx2")
+XOODOO_FLATTEN
+static inline void
+permute_x8(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  __m256i s[12];
+  for (size_t i = 0; i < 12; i++) {
+    s[i] = _mm256_loadu_si256((const __m256i*)(state + i * 8));
+  }
+
+  apply_rounds_x8<ROUNDS - n_rounds>(s);
+
+  for (size_t i = 0; i < 12; i++) {
+    _mm256_storeu_si256((__m256i*)(state + i * 8), s[i]);
+  }
+}
+
+// Xoodoo[n] ( = 12, by default ) permutation, applied on 16 lane-transposed
+// states at once, using AVX2 intrinsics, where each row of states is split
+// between two 256 -bit registers s.t. low and high 8 states are permuted in
+// interleaved fashion.
+template<const size_t n_rounds = ROUNDS>
+XOODOO_TARGET("avx2")
+XOODOO_FLATTEN
+static inline void
+permute_x16(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  __m256i s_lo[12];
+  __m256i s_hi[12];
+  for (size_t i = 0; i < 12; i++) {
+    s_lo[i] = _mm256_loadu_si256((const __m256i*)(state + i * 16 + 0));
+    s_hi[i] = _mm256_loadu_si256((const __m256i*)(state + i * 16 + 8));
+  }
+
+  apply_rounds_x8<ROUNDS - n_rounds>(s_lo, s_hi);
+
+  for (size_t i = 0; i < 12; i++) {
+    _mm256_storeu_si256((__m256i*)(state + i * 16 + 0), s_lo[i]);
+    _mm256_storeu_si256((__m256i*)(state + i * 16 + 8), s_hi[i]);
+  }
+}
+
+}
+
+// Multi-state Xoodoo permutation, using AVX-512F ( and AVX-512VL, for 256 -bit
+// registers ) intrinsics
+namespace avx512 {
+
+// Given a 512 -bit AVX-512 register holding 16 lanes ( each of 32 -bit ), this
+// function rotates each lane leftwards by v -bits, using native lane rotation.
+//
+// Note, masked form ( with all lanes selected ) is used, because GCC-12's
+// unmasked `_mm512_rol_epi32` trips `-Wuninitialized`, on its internal use of
+// `_mm512_undefined_epi32()`
+template<const int v>
+XOODOO_TARGET("avx512f")
+static inline __m512i
+rotl_x16(const __m512i lanes)
+{
+  static_assert(v > 0 && v < 32, "Can't rotate 32 -bit integer by ∉ [1, 32)");
+  return _mm512_mask_rol_epi32(lanes, 0xffff, lanes, v);
+}
+
+// Single round ( which specific round it is, denoted by `r_idx` ∈ [0, 12) ) of
+// Xoodoo permutation, applied on 16 lane-transposed states at once, s.t. each
+// row of states is kept in one 512 -bit AVX-512 register.
+//
+// Lane rotations are native ( see `vprold` ), while three-input boolean
+// functions of θ and χ are computed with single ternary-logic instruction (
+// see `vpternlogd` ), where immediate operand is truth table of function f(a,
+// b, c), indexed by (a << 2) | (b << 1) | c
+//
+// - 0x96 : a ^ b ^ c
+// - 0xd2 : a ^ (~b & c)
+//
+// See algorithm 1 of Xoodyak specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/xoodyak-spec-final.pdf
+template<const size_t r_idx>
+XOODOO_TARGET("avx512f")
+XOODOO_UNROLLED
+static inline void
+round_x16(__m512i* const s)
+  requires(r_idx < ROUNDS)
+{
+  // mixing layer θ
+  __m512i r5[4];
+  __m512i r14[4];
+  for (size_t x = 0; x < 4; x++) {
+    const size_t x_ = (x + 3) & 3;
+    const auto p = _mm512_ternarylogic_epi32(s[x_], s[4 + x_], s[8 + x_], 0x96);
+
+    r5[x] = rotl_x16<5>(p);
+    r14[x] = rotl_x16<14>(p);
+  }
+
+  for (size_t i = 0; i < 12; i++) {
+    s[i] = _mm512_ternarylogic_epi32(s[i], r5[i & 3], r14[i & 3], 0x96);
+  }
+
+  // plane shifting ρ_west
+  const auto t = s[7];
+  s[7] = s[6];
+  s[6] = s[5];
+  s[5] = s[4];
+  s[4] = t;
+
+  for (size_t x = 0; x < 4; x++) {
+    s[8 + x] = rotl_x16<11>(s[8 + x]);
+  }
+
+  // addition of round constant ι
+  s[0] = _mm512_xor_si512(s[0], _mm512_set1_epi32(RC[r_idx]));
+
+  // non-linear layer χ
+  for (size_t x = 0; x < 4; x++) {
+    const auto a0 = s[x];
+    const auto a1 = s[4 + x];
+    const auto a2 = s[8 + x];
+
+    s[x] = _mm512_ternarylogic_epi32(a0, a1, a2, 0xd2);
+    s[4 + x] = _mm512_ternarylogic_epi32(a1, a2, a0, 0xd2);
+    s[8 + x] = _mm512_ternarylogic_epi32(a2, a0, a1, 0xd2);
+  }
+
+  // plane shifting ρ_east
+  for (size_t x = 0; x < 4; x++) {
+    s[4 + x] = rotl_x16<1>(s[4 + x]);
+  }
+
+  const auto t0 = rotl_x16<8>(s[10]);
+  const auto t1 = rotl_x16<8>(s[11]);
+  s[10] = rotl_x16<8>(s[8]);
+  s[11] = rotl_x16<8>(s[9]);
+  s[8] = t0;
+  s[9] = t1;
+}
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on 16
+// lane-transposed states, unrolled at compile-time, using template recursion.
+template<const size_t r_idx>
+XOODOO_TARGET("avx512f")
+XOODOO_UNROLLED
+static inline void
+apply_rounds_x16(__m512i* const s)
+{
+  if constexpr (r_idx < ROUNDS) {
+    round_x16<r_idx>(s);
+    apply_rounds_x16<r_idx + 1>(s);
+  }
+}
+
+// Xoodoo[n] ( = 12, by default ) permutation, applied on 16 lane-transposed
+// states at once, using AVX-512 intrinsics.
+template<const size_t n_rounds = ROUNDS>
+XOODOO_TARGET("avx512f")
+XOODOO_FLATTEN
+static inline void
+permute_x16(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  __m512i s[12];
+  for (size_t i = 0; i < 12; i++) {
+    s[i] = _mm512_loadu_si512((const void*)(state + i * 16));
+  }
+
+  apply_rounds_x16<ROUNDS - n_rounds>(s);
+
+  for (size_t i = 0; i < 12; i++) {
+    _mm512_storeu_si512((void*)(state + i * 16), s[i]);
+  }
+}
+
+// Single round ( which specific round it is, denoted by `r_idx` ∈ [0, 12) ) of
+// Xoodoo permutation, applied on 8 lane-transposed states at once, s.t. each
+// row of states is kept in one 256 -bit register, using AVX-512VL intrinsics.
+// Compared to AVX2 implementation, it benefits from native lane rotation,
+// ternary-logic and twice as many architectural registers.
+template<const size_t r_idx>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_UNROLLED
+static inline void
+round_x8(__m256i* const s)
+  requires(r_idx < ROUNDS)
+{
+  // mixing layer θ
+  __m256i r5[4];
+  __m256i r14[4];
+  for (size_t x = 0; x < 4; x++) {
+    const size_t x_ = (x + 3) & 3;
+    const auto p = _mm256_ternarylogic_epi32(s[x_], s[4 + x_], s[8 + x_], 0x96);
+
+    r5[x] = _mm256_rol_epi32(p, 5);
+    r14[x] = _mm256_rol_epi32(p, 14);
+  }
+
+  for (size_t i = 0; i < 12; i++) {
+    s[i] = _mm256_ternarylogic_epi32(s[i], r5[i & 3], r14[i & 3], 0x96);
+  }
+
+  // plane shifting ρ_west
+  const auto t = s[7];
+  s[7] = s[6];
+  s[6] = s[5];
+  s[5] = s[4];
+  s[4] = t;
+
+  for (size_t x = 0; x < 4; x++) {
+    s[8 + x] = _mm256_rol_epi32(s[8 + x], 11);
+  }
+
+  // addition of round constant ι
+  s[0] = _mm256_xor_si256(s[0], _mm256_set1_epi32(RC[r_idx]));
+
+  // non-linear layer χ
+  for (size_t x = 0; x < 4; x++) {
+    const auto a0 = s[x];
+    const auto a1 = s[4 + x];
+    const auto a2 = s[8 + x];
+
+    s[x] = _mm256_ternarylogic_epi32(a0, a1, a2, 0xd2);
+    s[4 + x] = _mm256_ternarylogic_epi32(a1, a2, a0, 0xd2);
+    s[8 + x] = _mm256_ternarylogic_epi32(a2, a0, a1, 0xd2);
+  }
+
+  // plane shifting ρ_east
+  for (size_t x = 0; x < 4; x++) {
+    s[4 + x] = _mm256_rol_epi32(s[4 + x], 1);
+  }
+
+  const auto t0 = _mm256_rol_epi32(s[10], 8);
+  const auto t1 = _mm256_rol_epi32(s[11], 8);
+  s[10] = _mm256_rol_epi32(s[8], 8);
+  s[11] = _mm256_rol_epi32(s[9], 8);
+  s[8] = t0;
+  s[9] = t1;
+}
+
+// Applies rounds r_idx, r_idx + 1, ..., 11 of Xoodoo permutation on 8
+// lane-transposed states, unrolled at compile-time, using template recursion.
+template<const size_t r_idx>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_UNROLLED
+static inline void
+apply_rounds_x8(__m256i* const s)
+{
+  if constexpr (r_idx < ROUNDS) {
+    round_x8<r_idx>(s);
+    apply_rounds_x8<r_idx + 1>(s);
+  }
+}
+
+// Xoodoo[n] ( = 12, by default ) permutation, applied on 8 lane-transposed
+// states at once, using AVX-512VL intrinsics.
+template<const size_t n_rounds = ROUNDS>
+XOODOO_TARGET("avx512f,avx512vl")
+XOODOO_FLATTEN
+static inline void
+permute_x8(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  __m256i s[12];
+  for (size_t i = 0; i < 12; i++) {
+    s[i] = _mm256_loadu_si256((const __m256i*)(state + i * 8));
+  }
+
+  apply_rounds_x8<ROUNDS - n_rounds>(s);
+
+  for (size_t i = 0; i < 12; i++) {
+    _mm256_storeu_si256((__m256i*)(state + i * 8), s[i]);
+  }
+}
+
+}
+
+#endif
+
+// Signature of routine applying Xoodoo permutation on lane-transposed states
+using permute_batch_fn_t = void (*)(uint32_t* const);
+
+// Given an instruction set extension, this routine returns implementation of
+// Xoodoo[n] ( = 12, by default ) permutation on 8 lane-transposed states, best
+// suited for it.
+//
+// It's caller's responsibility to ensure that executing CPU supports `isa`.
+template<const size_t n_rounds = ROUNDS>
+static inline permute_batch_fn_t
+permute_x8_kernel(const isa_t isa)
+  requires(check_rounds(n_rounds))
+{
+#if defined XOODOO_X86
+  if (isa >= isa_t::avx512) {
+    return avx512::permute_x8<n_rounds>;
+  }
+  if (isa >= isa_t::avx2) {
+    return avx2::permute_x8<n_rounds>;
+  }
+#endif
+
+  return permute_xN<8, n_rounds>;
+}
+
+// Given an instruction set extension, this routine returns implementation of
+// Xoodoo[n] ( = 12, by default ) permutation on 16 lane-transposed states, best
+// suited for it.
+//
+// It's caller's responsibility to ensure that executing CPU supports `isa`.
+template<const size_t n_rounds = ROUNDS>
+static inline permute_batch_fn_t
+permute_x16_kernel(const isa_t isa)
+  requires(check_rounds(n_rounds))
+{
+#if defined XOODOO_X86
+  if (isa >= isa_t::avx512) {
+    return avx512::permute_x16<n_rounds>;
+  }
+  if (isa >= isa_t::avx2) {
+    return avx2::permute_x16<n_rounds>;
+  }
+#endif
+
+  return permute_xN<16, n_rounds>;
+}
+
+// Xoodoo[n] ( = 12, by default ) permutation, applied on 8 lane-transposed
+// states at once, using best implementation available on executing CPU, which
+// is chosen on first call
+template<const size_t n_rounds = ROUNDS>
+static inline void
+permute_x8(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  static const permute_batch_fn_t fn =
+    permute_x8_kernel<n_rounds>(active_isa());
+  fn(state);
+}
+
+// Xoodoo[n] ( = 12, by default ) permutation, applied on 16 lane-transposed
+// states at once, using best implementation available on executing CPU, which
+// is chosen on first call
+template<const size_t n_rounds = ROUNDS>
+static inline void
+permute_x16(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  static const permute_batch_fn_t fn =
+    permute_x16_kernel<n_rounds>(active_isa());
+  fn(state);
+}
+
+// Applies Xoodoo[n] ( = 12, by default ) permutation on N lane-transposed
+// states, choosing the widest available multi-state implementation for given N.
+template<const size_t N, const size_t n_rounds = ROUNDS>
+static inline void
+permute_batch(uint32_t* const state)
+  requires(check_rounds(n_rounds))
+{
+  if constexpr (N == 8) {
+    permute_x8<n_rounds>(state);
+  } else if constexpr (N == 16) {
+    permute_x16<n_rounds>(state);
+  } else {
+    permute_xN<N, n_rounds>(state);
+  }
+}
+
+}
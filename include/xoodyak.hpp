@@ -1,5 +1,9 @@
 #pragma once
 #include "cyclist.hpp"
+#include "cyclist_batch.hpp"
+#include "cyclist_reg.hpp"
+#include <array>
+#include <string_view>
 
 // Xoodyak Cryptographic Suite --- Hash function, Authenticated Encryption with
 // Associated Data ( read AEAD ) scheme
@@ -20,23 +24,112 @@ constexpr size_t DIGEST_LEN = 32ul;
 //
 // Given N -bytes input message, this function absorbs input into permutation
 // state & squeezes out 32 -bytes as digest of consumed input bytes
+//
+// When executing CPU supports SSE2 ( or better ), permutation state is kept in
+// registers, for whole message; see `cyclist_reg.hpp`.
 static inline void
 hash(const uint8_t* const __restrict msg, // N -bytes input message to be hashed
      const size_t m_len,                  // len(msg) | >= 0
      uint8_t* const __restrict out        // 32 -bytes digest of `msg`
 )
 {
+  static const auto fn = cyclist::reg::hash_kernel(xoodoo::active_isa());
+  if (fn != nullptr) {
+    fn(msg, m_len, out);
+    return;
+  }
+
   cyclist::phase_t ph = cyclist::phase_t::Up;
 
-#if defined __SSE2__ && USE_SSE2 != 0
-  alignas(16)
-#endif
-    uint32_t state[12]{};
+  alignas(16) uint32_t state[12]{};
 
   cyclist::absorb<cyclist::mode_t::Hash>(state, msg, m_len, &ph);
   cyclist::squeeze<cyclist::mode_t::Hash>(state, out, DIGEST_LEN, &ph);
 }
 
+namespace ct {
+
+// Compile-time evaluable Xoodyak hash, following `absorb(...)` and
+// `squeeze(...)` routines of Cyclist hashing mode, while touching permutation
+// state only lane-wise ( never through `std::memcpy` ) and using portable
+// `constexpr` Xoodoo permutation, so that digest can be computed by compiler.
+//
+// Message bytes are read as `static_cast<uint8_t>(msg[i])`, so that both byte
+// arrays and character strings can be hashed.
+template<typename T>
+static inline constexpr std::array<uint8_t, DIGEST_LEN>
+hash(const T* const msg, const size_t m_len)
+{
+  constexpr size_t rate = cyclist::R_Hash;
+
+  std::array<uint32_t, 12> state{};
+  std::array<uint8_t, DIGEST_LEN> out{};
+
+  // absorb message, block by block; empty message is absorbed as single empty
+  // block, while only first one carries domain seperator color
+  size_t off = 0ul;
+  do {
+    if (off > 0ul) {
+      xoodoo::scalar::permute(state.data());
+    }
+
+    const size_t read = std::min(rate, m_len - off);
+    for (size_t i = 0; i < read; i++) {
+      const auto b = static_cast<uint32_t>(static_cast<uint8_t>(msg[off + i]));
+      state[i >> 2] ^= b << ((i & 3ul) << 3);
+    }
+
+    state[read >> 2] ^= 0x01u << ((read & 3ul) << 3);
+    if (off == 0ul) {
+      state[11] ^= static_cast<uint32_t>(cyclist::Absorb_Color_Hash) << 24;
+    }
+
+    off += read;
+  } while (off < m_len);
+
+  // squeeze digest, in two blocks, with an empty block absorbed in between
+  for (size_t blk = 0; blk < DIGEST_LEN / rate; blk++) {
+    if (blk > 0ul) {
+      state[0] ^= 0x01u;
+    }
+
+    xoodoo::scalar::permute(state.data());
+
+    for (size_t i = 0; i < rate; i++) {
+      const uint32_t lane = state[i >> 2] >> ((i & 3ul) << 3);
+      out[blk * rate + i] = static_cast<uint8_t>(lane);
+    }
+  }
+
+  return out;
+}
+
+}
+
+// Xoodyak cryptographic hash function, which can be evaluated at compile-time,
+// so that digest of a constant message can be embedded in binary, as
+//
+// `constexpr auto digest = xoodyak::hash(std::array<uint8_t, 4>{ 1, 2, 3, 4 });`
+//
+// Computes same digest as `hash(msg, N, out)`. When called at run-time, it uses
+// portable Xoodoo permutation; prefer pointer based `hash(...)` there.
+template<const size_t N>
+static inline constexpr std::array<uint8_t, DIGEST_LEN>
+hash(const std::array<uint8_t, N>& msg)
+{
+  return ct::hash(msg.data(), N);
+}
+
+// Xoodyak cryptographic hash function, which computes digest of a string (
+// without any terminating null byte ) at compile-time, as
+//
+// `constexpr auto digest = xoodyak::hash("abc");`
+static inline consteval std::array<uint8_t, DIGEST_LEN>
+hash(const std::string_view msg)
+{
+  return ct::hash(msg.data(), msg.size());
+}
+
 // Xoodyak Authenticated Encryption with Associated Data routine, which given 16
 // -bytes secret key, 16 -bytes public message nonce, N -bytes associated data (
 // never encryted ) & M -bytes plain text data ( it'll be encrypted ), computes
@@ -53,12 +146,15 @@ encrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
         uint8_t* const __restrict tag         // 128 -bit authentication tag
 )
 {
+  static const auto fn = cyclist::reg::aead_kernel<false>(xoodoo::active_isa());
+  if (fn != nullptr) {
+    fn(key, nonce, data, dt_len, text, cipher, ct_len, tag);
+    return;
+  }
+
   cyclist::phase_t ph = cyclist::phase_t::Up;
 
-#if defined __SSE2__ && USE_SSE2 != 0
-  alignas(16)
-#endif
-    uint32_t state[12]{};
+  alignas(16) uint32_t state[12]{};
 
   cyclist::absorb_key(state, key, nonce, &ph);
   cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
@@ -84,18 +180,20 @@ decrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
         const size_t ct_len                     // len(cipher) == len(text)
 )
 {
-  cyclist::phase_t ph = cyclist::phase_t::Up;
-
-#if defined __SSE2__ && USE_SSE2 != 0
-  alignas(16)
-#endif
-    uint32_t state[12]{};
   uint8_t tag_[16]{};
 
-  cyclist::absorb_key(state, key, nonce, &ph);
-  cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
-  cyclist::decrypt(state, cipher, text, ct_len, &ph);
-  cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag_, 16ul, &ph);
+  static const auto fn = cyclist::reg::aead_kernel<true>(xoodoo::active_isa());
+  if (fn != nullptr) {
+    fn(key, nonce, data, dt_len, cipher, text, ct_len, tag_);
+  } else {
+    cyclist::phase_t ph = cyclist::phase_t::Up;
+    alignas(16) uint32_t state[12]{};
+
+    cyclist::absorb_key(state, key, nonce, &ph);
+    cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
+    cyclist::decrypt(state, cipher, text, ct_len, &ph);
+    cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag_, 16ul, &ph);
+  }
 
   bool f = false;
 
@@ -121,4 +219,241 @@ decrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
   return !f;
 }
 
+// Xoodyak Authenticated Encryption with Associated Data routine, which given 16
+// -bytes secret key, 16 -bytes public message nonce, N -bytes associated data &
+// M -bytes plain text, encrypts plain text in place ( i.e. overwriting it with
+// M -bytes cipher text ) & computes 16 -bytes authentication tag.
+//
+// Produces exactly same cipher text and tag as `encrypt(...)` does.
+static inline void
+encrypt_inplace(
+  const uint8_t* const __restrict key,   // 128 -bit secret key
+  const uint8_t* const __restrict nonce, // 128 -bit public message nonce
+  const uint8_t* const __restrict data,  // N (>= 0) -bytes associated data
+  const size_t dt_len,                   // len(data)
+  uint8_t* const __restrict buf,         // M (>= 0) -bytes plain/ cipher text
+  const size_t ct_len,                   // len(buf)
+  uint8_t* const __restrict tag          // 128 -bit authentication tag
+)
+{
+  // register-resident engine reads input before writing output
+  static const auto fn = cyclist::reg::aead_kernel<false>(xoodoo::active_isa());
+  if (fn != nullptr) {
+    fn(key, nonce, data, dt_len, buf, buf, ct_len, tag);
+    return;
+  }
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  cyclist::absorb_key(state, key, nonce, &ph);
+  cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
+  cyclist::crypt_inplace<false>(state, buf, ct_len, &ph);
+  cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag, 16ul, &ph);
+}
+
+// Xoodyak Verified Decryption with Associated Data routine, which given 16
+// -bytes secret key, 16 -bytes public message nonce, 16 -bytes authentication
+// tag, N -bytes associated data & M -bytes cipher text, decrypts cipher text in
+// place ( i.e. overwriting it with M -bytes plain text ), returning boolean
+// flag denoting verification status.
+//
+// Note, if verification fails, buffer is zeroed, so unverified plain text is
+// never released.
+static inline bool
+decrypt_inplace(
+  const uint8_t* const __restrict key,   // 128 -bit secret key
+  const uint8_t* const __restrict nonce, // 128 -bit public message nonce
+  const uint8_t* const __restrict tag,   // 128 -bit authentication tag
+  const uint8_t* const __restrict data,  // N (>= 0) -bytes associated data
+  const size_t dt_len,                   // len(data)
+  uint8_t* const __restrict buf,         // M (>= 0) -bytes cipher/ plain text
+  const size_t ct_len                    // len(buf)
+)
+{
+  uint8_t tag_[16]{};
+
+  // register-resident engine reads input before writing output
+  static const auto fn = cyclist::reg::aead_kernel<true>(xoodoo::active_isa());
+  if (fn != nullptr) {
+    fn(key, nonce, data, dt_len, buf, buf, ct_len, tag_);
+  } else {
+    cyclist::phase_t ph = cyclist::phase_t::Up;
+    alignas(16) uint32_t state[12]{};
+
+    cyclist::absorb_key(state, key, nonce, &ph);
+    cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
+    cyclist::crypt_inplace<true>(state, buf, ct_len, &ph);
+    cyclist::squeeze<cyclist::mode_t::Keyed>(state, tag_, 16ul, &ph);
+  }
+
+  bool f = false;
+  for (size_t i = 0; i < 16; i++) {
+    f |= static_cast<bool>(tag[i] ^ tag_[i]);
+  }
+
+  // don't release unverified plain text !
+  std::memset(buf, 0, f * ct_len);
+  return !f;
+}
+
+// Xoodyak Verified Decryption with Associated Data routine, which takes same
+// arguments as `decrypt(...)` and computes same plain text, but verifies
+// authentication tag before writing any plain text to caller's buffer. Cipher
+// text is decrypted into a scratch block, only for absorbing plain text into
+// permutation state, and once computed tag matches expected one, it's decrypted
+// again, from snapshot of state taken before first pass, this time writing
+// plain text out.
+//
+// So when verification fails, plain text buffer is left untouched ( it's
+// neither written nor zeroed ), which saves two passes over it, for forged
+// inputs, at the cost of reading cipher text twice, for genuine ones. Cipher
+// text and plain text are allowed to be same buffer.
+static inline bool
+verify_then_decrypt(
+  const uint8_t* const __restrict key,   // 128 -bit secret key
+  const uint8_t* const __restrict nonce, // 128 -bit public message nonce
+  const uint8_t* const __restrict tag,   // 128 -bit authentication tag
+  const uint8_t* const __restrict data,  // N (>= 0) -bytes associated data
+  const size_t dt_len,                   // len(data)
+  const uint8_t* const cipher,           // M (>=0) -bytes cipher text
+  uint8_t* const text,                   // M (>=0) -bytes plain text
+  const size_t ct_len                    // len(cipher) == len(text)
+)
+{
+  static const auto fn = cyclist::reg::aead_verify_kernel(xoodoo::active_isa());
+  if (fn != nullptr) {
+    return fn(key, nonce, tag, data, dt_len, cipher, text, ct_len);
+  }
+
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(16) uint32_t state[12]{};
+
+  cyclist::absorb_key(state, key, nonce, &ph);
+  cyclist::absorb<cyclist::mode_t::Keyed>(state, data, dt_len, &ph);
+
+  cyclist::phase_t ph0 = ph;
+  alignas(16) uint32_t state0[12];
+  std::memcpy(state0, state, sizeof(state));
+
+  cyclist::crypt_discard(state, cipher, ct_len, &ph);
+  if (!cyclist::squeeze_verify<cyclist::mode_t::Keyed>(state, tag, 16ul, &ph)) {
+    return false;
+  }
+
+  cyclist::crypt_any<true>(state0, cipher, text, ct_len, &ph0);
+  return true;
+}
+
+// Xoodyak cryptographic hash function, computing digests of N independent,
+// equal length messages at once, by keeping N permutation states side by side
+// and permuting them together, using multi-state Xoodoo permutation ( N = 8
+// maps onto AVX2 registers, when enabled ).
+//
+// Produces exactly same digests as N independent calls to `hash(...)`
+template<const size_t N>
+static inline void
+hash_xN(const uint8_t* const* const __restrict msg, // N messages, to be hashed
+        const size_t m_len,                         // len(msg[i]) | >= 0
+        uint8_t* const* const __restrict out        // N 32 -bytes digests
+)
+{
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(32) uint32_t state[12 * N]{};
+
+  cyclist::absorb_any_xN<N,
+                         cyclist::mode_t::Hash,
+                         cyclist::R_Hash,
+                         cyclist::Absorb_Color_Hash>(state, msg, m_len, &ph);
+  cyclist::squeeze_any_xN<N,
+                          cyclist::mode_t::Hash,
+                          cyclist::R_Hash,
+                          cyclist::Squeeze_Color>(state, out, DIGEST_LEN, &ph);
+}
+
+// Xoodyak Authenticated Encryption with Associated Data routine, encrypting N
+// independent messages at once ( each under its own key and nonce ), where all
+// N associated data are of same length and so are all N plain texts.
+//
+// Produces exactly same cipher texts and tags as N independent calls to
+// `encrypt(...)`
+template<const size_t N>
+static inline void
+encrypt_xN(const uint8_t* const* const __restrict key,   // N 128 -bit keys
+           const uint8_t* const* const __restrict nonce, // N 128 -bit nonces
+           const uint8_t* const* const __restrict data,  // N associated data
+           const size_t dt_len,                          // len(data[i])
+           const uint8_t* const* const __restrict text,  // N plain texts
+           uint8_t* const* const __restrict cipher,      // N cipher texts
+           const size_t ct_len,                          // len(text[i])
+           uint8_t* const* const __restrict tag          // N 128 -bit tags
+)
+{
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(32) uint32_t state[12 * N]{};
+
+  cyclist::absorb_key_xN<N>(state, key, nonce, &ph);
+  cyclist::absorb_any_xN<N,
+                         cyclist::mode_t::Keyed,
+                         cyclist::R_Kin,
+                         cyclist::Absorb_Color_Keyed>(state, data, dt_len, &ph);
+  cyclist::crypt_xN<N, false>(state, text, cipher, ct_len, &ph);
+  cyclist::squeeze_any_xN<N,
+                          cyclist::mode_t::Keyed,
+                          cyclist::R_Kout,
+                          cyclist::Squeeze_Color>(state, tag, 16ul, &ph);
+}
+
+// Xoodyak Verified Decryption with Associated Data routine, decrypting N
+// independent messages at once, where all N associated data are of same length
+// and so are all N cipher texts. Verification status of i-th message is written
+// to `flag[i]`, while plain text of each message, which fails verification, is
+// zeroed.
+//
+// Note, before consuming i-th decrypted message ensure `flag[i]` is truth value
+template<const size_t N>
+static inline void
+decrypt_xN(const uint8_t* const* const __restrict key,    // N 128 -bit keys
+           const uint8_t* const* const __restrict nonce,  // N 128 -bit nonces
+           const uint8_t* const* const __restrict tag,    // N 128 -bit tags
+           const uint8_t* const* const __restrict data,   // N associated data
+           const size_t dt_len,                           // len(data[i])
+           const uint8_t* const* const __restrict cipher, // N cipher texts
+           uint8_t* const* const __restrict text,         // N plain texts
+           const size_t ct_len,                           // len(cipher[i])
+           bool* const __restrict flag                    // N verification flags
+)
+{
+  cyclist::phase_t ph = cyclist::phase_t::Up;
+  alignas(32) uint32_t state[12 * N]{};
+
+  uint8_t tag_[N][16]{};
+  uint8_t* tag_ptr[N];
+  for (size_t j = 0; j < N; j++) {
+    tag_ptr[j] = tag_[j];
+  }
+
+  cyclist::absorb_key_xN<N>(state, key, nonce, &ph);
+  cyclist::absorb_any_xN<N,
+                         cyclist::mode_t::Keyed,
+                         cyclist::R_Kin,
+                         cyclist::Absorb_Color_Keyed>(state, data, dt_len, &ph);
+  cyclist::crypt_xN<N, true>(state, cipher, text, ct_len, &ph);
+  cyclist::squeeze_any_xN<N,
+                          cyclist::mode_t::Keyed,
+                          cyclist::R_Kout,
+                          cyclist::Squeeze_Color>(state, tag_ptr, 16ul, &ph);
+
+  for (size_t j = 0; j < N; j++) {
+    bool f = false;
+    for (size_t i = 0; i < 16; i++) {
+      f |= static_cast<bool>(tag[j][i] ^ tag_[j][i]);
+    }
+
+    // don't release unverified plain text !
+    std::memset(text[j], 0, f * ct_len);
+    flag[j] = !f;
+  }
+}
+
 }
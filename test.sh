@@ -2,8 +2,9 @@
 
 # Script for ease of execution of Known Answer Tests against Xoodyak implementation
 
-# generate shared library object
+# generate shared library object & native Python extension module
 make lib
+make pylib
 
 # ---
 
@@ -1,9 +1,23 @@
+#include "test/test_tool.hpp"
+#include "test/test_xoodoo.hpp"
 #include "test/test_xoodyak.hpp"
 #include <iostream>
 
 int
 main()
 {
+  for (size_t i = 0; i < 64; i++) {
+    test_xoodoo::permute();
+    test_xoodoo::permute_batch();
+
+    test_xoodoo::permute<6>();
+    test_xoodoo::permute_batch<6>();
+    test_xoodoo::permute_reduced<1>();
+    test_xoodoo::permute_reduced<6>();
+  }
+
+  std::cout << "[test] Xoodoo permutation implementations work !" << std::endl;
+
   constexpr size_t min_ct_len = 0ul;
   constexpr size_t min_dt_len = 0ul;
   constexpr size_t max_ct_len = 64ul;
@@ -22,5 +36,189 @@ main()
 
   std::cout << "[test] Xoodyak AEAD works !" << std::endl;
 
+  for (size_t i = 0; i < 128; i++) {
+    test_xoodyak::hash_xN<2>(i);
+    test_xoodyak::hash_xN<8>(i);
+    test_xoodyak::hash_xN<16>(i);
+  }
+
+  std::cout << "[test] Xoodyak multi-message Hash works !" << std::endl;
+
+  for (size_t i = 0; i < 256; i++) {
+    test_xoodyak::hasher(i);
+  }
+
+  std::cout << "[test] Xoodyak incremental Hash works !" << std::endl;
+
+  for (size_t i = min_ct_len; i < max_ct_len; i++) {
+    for (size_t j = min_dt_len; j < max_dt_len; j++) {
+      test_xoodyak::aead_xN<2>(j, i);
+      test_xoodyak::aead_xN<8>(j, i);
+      test_xoodyak::aead_xN<16>(j, i);
+    }
+  }
+
+  std::cout << "[test] Xoodyak multi-message AEAD works !" << std::endl;
+
+  for (size_t i = 0; i < 100; i++) {
+    for (size_t j = 0; j < 100; j++) {
+      test_xoodyak::aead_stream(j, i);
+    }
+  }
+
+  std::cout << "[test] Xoodyak online AEAD works !" << std::endl;
+
+  for (size_t i = min_ct_len; i < max_ct_len; i++) {
+    for (size_t j = min_dt_len; j < max_dt_len; j++) {
+      test_xoodyak::key_schedule(j, i);
+    }
+  }
+
+  std::cout << "[test] Xoodyak AEAD with key schedule works !" << std::endl;
+
+  for (size_t i = 0; i < 128; i++) {
+    test_xoodyak::aead_batch(i);
+  }
+
+  std::cout << "[test] Xoodyak multi-buffer AEAD works !" << std::endl;
+
+  for (size_t i = 0; i < 128; i++) {
+    test_xoodyak::hash_batch(i, 4);
+    test_xoodyak::hash_batch(i * 4, 3 * cyclist::R_Hash);
+  }
+
+  std::cout << "[test] Xoodyak multi-buffer Hash works !" << std::endl;
+
+  {
+    constexpr size_t leaf_len = xoodyak::TREE_LEAF_LEN;
+    constexpr size_t m_lens[]{ 0ul,
+                               1ul,
+                               leaf_len - 1,
+                               leaf_len,
+                               leaf_len + 1,
+                               8 * leaf_len,
+                               16 * leaf_len,
+                               17 * leaf_len + 13,
+                               40 * leaf_len - 1 };
+
+    for (const size_t m_len : m_lens) {
+      test_xoodyak::tree_hash(m_len);
+    }
+  }
+
+  std::cout << "[test] Xoodyak parallel tree Hash works !" << std::endl;
+
+  for (size_t i = 0; i < 64; i++) {
+    for (size_t j = 0; j < 160; j++) {
+      test_xoodyak::xof(i, j);
+    }
+  }
+
+  std::cout << "[test] Xoodyak XOF works !" << std::endl;
+
+  for (size_t i = min_ct_len; i < max_ct_len; i++) {
+    for (size_t j = min_dt_len; j < max_dt_len; j++) {
+      test_xoodyak::aead_inplace(j, i);
+    }
+  }
+
+  std::cout << "[test] Xoodyak in-place AEAD works !" << std::endl;
+
+  for (size_t i = 0; i < 100; i++) {
+    for (size_t j = 0; j < 100; j++) {
+      test_xoodyak::cyclist_reg(j, i);
+    }
+  }
+
+  std::cout << "[test] Register-resident Cyclist engines work !" << std::endl;
+
+  for (size_t i = 0; i < 128; i++) {
+    test_xoodyak::hash_constexpr(i);
+  }
+
+  std::cout << "[test] Xoodyak compile-time Hash works !" << std::endl;
+
+  for (size_t i = 0; i < 100; i++) {
+    for (size_t j = 1; j < 80; j++) {
+      test_xoodyak::mac(i, j);
+    }
+  }
+
+  std::cout << "[test] Xoodyak MAC works !" << std::endl;
+
+  for (size_t i = 0; i < 128; i++) {
+    test_xoodyak::mac_batch(i);
+  }
+
+  std::cout << "[test] Xoodyak multi-buffer MAC works !" << std::endl;
+
+  for (size_t i = 0; i < 100; i++) {
+    for (size_t j = 0; j < 50; j++) {
+      test_xoodyak::session(j, i);
+    }
+  }
+
+  std::cout << "[test] Xoodyak session mode works !" << std::endl;
+
+  for (size_t i = min_ct_len; i < max_ct_len; i++) {
+    for (size_t j = min_dt_len; j < max_dt_len; j++) {
+      test_xoodyak::verify_then_decrypt(j, i);
+    }
+  }
+
+  std::cout << "[test] Xoodyak verify-before-decrypt works !" << std::endl;
+
+  for (size_t i = min_ct_len; i < max_ct_len; i++) {
+    for (size_t j = min_dt_len; j < max_dt_len; j++) {
+      test_xoodyak::scatter_gather(j, i * 3, 7);
+      test_xoodyak::scatter_gather(j, i * 3, 64);
+    }
+  }
+
+  std::cout << "[test] Xoodyak scatter-gather AEAD and Hash work !" << std::endl;
+
+  {
+    constexpr size_t chunk_len = 64ul;
+    constexpr size_t m_lens[]{ 0ul,
+                               1ul,
+                               chunk_len - 1,
+                               chunk_len,
+                               chunk_len + 1,
+                               8 * chunk_len,
+                               16 * chunk_len,
+                               17 * chunk_len + 13,
+                               40 * chunk_len - 1 };
+
+    for (const size_t m_len : m_lens) {
+      test_xoodyak::chunked(m_len, chunk_len, 1);
+      test_xoodyak::chunked(m_len, chunk_len, 3);
+      test_xoodyak::chunked(m_len, 7, 2);
+    }
+
+    test_xoodyak::chunked(100000, xoodyak::CHUNKED_CHUNK_LEN, 0);
+  }
+
+  std::cout << "[test] Xoodyak chunked AEAD works !" << std::endl;
+
+  {
+    constexpr size_t n_threads[]{ 1ul, 3ul, 0ul };
+
+    for (const size_t t : n_threads) {
+      test_xoodyak::hash_engine(0, 0, t);
+      test_xoodyak::hash_engine(7, 1, t);
+      test_xoodyak::hash_engine(3000, 8, t);
+    }
+  }
+
+  std::cout << "[test] Xoodyak batch hashing engine works !" << std::endl;
+
+  test_tool::mapped_file();
+
+  test_tool::mapped_out(0);
+  test_tool::mapped_out(1);
+  test_tool::mapped_out(100000);
+
+  std::cout << "[test] Memory-mapped tool input/ output works !" << std::endl;
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,256 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// Memory-mapped file input/ output, used by Xoodyak command-line tools
+namespace xoodyak_tool {
+
+// Read-only view of whole contents of a file, which is memory-mapped ( with
+// sequential access hint ), when it's a regular file, so that its pages are
+// fed to hash/ AEAD routines straight out of page cache, without any `read()`
+// copies. Anything else ( say pipe, standard input, special file or regular
+// file reporting zero size, as /proc and sysfs files do ) is read into heap
+// buffer, till end-of-file.
+//
+// On failure, `err` holds `errno` value, describing what went wrong.
+struct mapped_file_t
+{
+  const uint8_t* data = nullptr;
+  size_t len = 0ul;
+  int err = 0;
+  dev_t dev = 0;
+  ino_t ino = 0;
+
+private:
+  void* map = MAP_FAILED;
+  std::vector<uint8_t> buf;
+
+  // Reads from file descriptor till end-of-file, into heap buffer
+  inline void read_all(const int fd)
+  {
+    constexpr size_t step = 1ul << 16;
+
+    while (true) {
+      buf.resize(len + step);
+
+      const ssize_t n = ::read(fd, buf.data() + len, step);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+
+        err = errno;
+        return;
+      }
+      if (n == 0) {
+        break;
+      }
+
+      len += static_cast<size_t>(n);
+    }
+
+    buf.resize(len);
+    data = buf.data();
+  }
+
+public:
+  // Maps file at given path, where "-" denotes standard input
+  inline explicit mapped_file_t(const char* const path)
+  {
+    const bool std_in = (path[0] == '-') && (path[1] == '\0');
+    const int fd = std_in ? STDIN_FILENO : ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      err = errno;
+      return;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      err = errno;
+      st.st_dev = 0;
+      st.st_ino = 0;
+    } else if (S_ISDIR(st.st_mode)) {
+      err = EISDIR;
+    } else if (S_ISREG(st.st_mode) && (st.st_size > 0)) {
+      len = static_cast<size_t>(st.st_size);
+      map = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (map == MAP_FAILED) {
+        err = errno;
+        len = 0ul;
+      } else {
+        ::madvise(map, len, MADV_SEQUENTIAL);
+        data = static_cast<const uint8_t*>(map);
+      }
+    } else {
+      read_all(fd);
+    }
+
+    dev = st.st_dev;
+    ino = st.st_ino;
+
+    if (!std_in) {
+      ::close(fd);
+    }
+  }
+
+  inline ~mapped_file_t()
+  {
+    if (map != MAP_FAILED) {
+      ::munmap(map, len);
+    }
+  }
+
+  mapped_file_t(const mapped_file_t&) = delete;
+  mapped_file_t& operator=(const mapped_file_t&) = delete;
+
+  inline bool ok() const { return err == 0; }
+};
+
+// Writable view of a file of given length, which is written into a freshly
+// created temporary file ( in same directory as destination ), sized and
+// memory-mapped ( shared ), so that output is written straight into page cache.
+// Blocks are reserved upfront, where file system supports it, so that running
+// out of space is reported here, instead of as `SIGBUS`, while writing to
+// mapping. Once written, output must be made durable by calling `commit()`, as
+// write-back errors are reported only there, which also renames temporary file
+// over destination. Until then, any existing file at destination path is left
+// untouched, so partially written ( or unverified ) output is never exposed
+// there.
+//
+// On failure, `err` holds `errno` value, describing what went wrong.
+struct mapped_out_t
+{
+  uint8_t* data = nullptr;
+  size_t len = 0ul;
+  int err = 0;
+
+private:
+  const char* path;
+  std::string tmp_path;
+  int fd = -1;
+  void* map = MAP_FAILED;
+
+public:
+  inline mapped_out_t(const char* const path, const size_t len, mode_t mode)
+    : len(len)
+    , path(path)
+  {
+    const char* const slash = std::strrchr(path, '/');
+    if (slash != nullptr) {
+      tmp_path.assign(path, static_cast<size_t>(slash - path) + 1);
+    }
+    tmp_path += ".xoodyak-XXXXXX";
+
+    fd = ::mkostemp(tmp_path.data(), O_CLOEXEC);
+    if (fd < 0) {
+      err = errno;
+      tmp_path.clear();
+      return;
+    }
+
+    // temporary file is created with 0600, so apply requested mode, as `open`
+    // would have done, honouring umask
+    const mode_t mask = ::umask(0);
+    ::umask(mask);
+
+    if (::fchmod(fd, mode & ~mask) != 0) {
+      err = errno;
+      return;
+    }
+
+    if (len == 0ul) {
+      return;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(len)) != 0) {
+      err = errno;
+      return;
+    }
+
+    const int r = ::posix_fallocate(fd, 0, static_cast<off_t>(len));
+    if ((r != 0) && (r != EOPNOTSUPP) && (r != EINVAL)) {
+      err = r;
+      return;
+    }
+
+    map = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+      err = errno;
+      return;
+    }
+
+    ::madvise(map, len, MADV_SEQUENTIAL);
+    data = static_cast<uint8_t*>(map);
+  }
+
+  inline ~mapped_out_t()
+  {
+    if (map != MAP_FAILED) {
+      ::munmap(map, len);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  mapped_out_t(const mapped_out_t&) = delete;
+  mapped_out_t& operator=(const mapped_out_t&) = delete;
+
+  inline bool ok() const { return err == 0; }
+
+  // Flushes written pages to temporary file ( waiting for write-back to
+  // complete ), unmaps and closes it, before renaming it over destination,
+  // returning truth value only when all of them succeed, so that write-back
+  // errors ( say EIO/ ENOSPC/ EDQUOT ) are not lost in destructor. On failure,
+  // `err` holds first error and destination is left untouched.
+  inline bool commit()
+  {
+    if (map != MAP_FAILED) {
+      if ((::msync(map, len, MS_SYNC) != 0) && (err == 0)) {
+        err = errno;
+      }
+      if ((::munmap(map, len) != 0) && (err == 0)) {
+        err = errno;
+      }
+      map = MAP_FAILED;
+    }
+    if (fd >= 0) {
+      if ((::close(fd) != 0) && (err == 0)) {
+        err = errno;
+      }
+      fd = -1;
+    }
+    if ((err == 0) && !tmp_path.empty()) {
+      if (::rename(tmp_path.c_str(), path) != 0) {
+        err = errno;
+      } else {
+        tmp_path.clear();
+      }
+    }
+
+    return err == 0;
+  }
+
+  // Removes ( partially written or unverified ) temporary output file, leaving
+  // destination path untouched
+  inline void discard()
+  {
+    if (!tmp_path.empty()) {
+      ::unlink(tmp_path.c_str());
+      tmp_path.clear();
+    }
+  }
+};
+
+}
@@ -0,0 +1,288 @@
+#include "chunked.hpp"
+#include "mapped_file.hpp"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/random.h>
+
+// Xoodyak file sealing tool, which encrypts ( or decrypts ) a file into chunked
+// AEAD container ( see `chunked.hpp` ), under 16 -bytes secret key, read from
+// key file, while sealing chunks in parallel, across all available cores. Both
+// input and output files are memory-mapped, so chunks are encrypted straight
+// from/ into page cache. Each container is sealed under fresh random nonce.
+// Output is written into a temporary file, which replaces OUT only once it's
+// completely written ( and, when opening, authenticated ), so a tampered
+// container never clobbers existing OUT nor exposes unverified plain text.
+//
+// Compile it with
+//
+// make tools
+//
+// Usage
+//
+// xoodyak-seal -k KEYFILE [-j N] [-s CHUNK] IN OUT  seal IN into OUT
+// xoodyak-seal -d -k KEYFILE [-j N] IN OUT          open IN into OUT
+//
+// Key file holds either 16 raw bytes or 32 hex digits ( optionally followed by
+// new line ).
+
+namespace {
+
+constexpr size_t knt_len = 16ul;
+
+void
+usage()
+{
+  std::fputs(
+    "Usage: xoodyak-seal [-d] -k KEYFILE [-j N] [-s CHUNK] IN OUT\n"
+    "Seal ( or open ) IN into OUT, using chunked Xoodyak AEAD.\n\n"
+    "  -d          open sealed container, instead of sealing\n"
+    "  -k KEYFILE  16 raw bytes or 32 hex digits of secret key\n"
+    "  -j N        use N worker threads ( default: all cores )\n"
+    "  -s CHUNK    chunk length in bytes, when sealing ( default: 65536 )\n",
+    stderr);
+}
+
+int
+from_hex_digit(const char c)
+{
+  if ((c >= '0') && (c <= '9')) {
+    return c - '0';
+  }
+  if ((c >= 'a') && (c <= 'f')) {
+    return c - 'a' + 10;
+  }
+  if ((c >= 'A') && (c <= 'F')) {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+
+// Reads 16 -bytes secret key from key file, returning truth value only when
+// it's well-formed
+bool
+read_key(const char* const path, uint8_t* const key)
+{
+  const xoodyak_tool::mapped_file_t f(path);
+  if (!f.ok()) {
+    std::fprintf(stderr, "xoodyak-seal: %s: %s\n", path, std::strerror(f.err));
+    return false;
+  }
+
+  if (f.len == knt_len) {
+    std::memcpy(key, f.data, knt_len);
+    return true;
+  }
+
+  size_t len = f.len;
+  while ((len > 0) && std::isspace(f.data[len - 1])) {
+    len--;
+  }
+
+  if (len != 2 * knt_len) {
+    std::fprintf(stderr, "xoodyak-seal: %s: malformed key\n", path);
+    return false;
+  }
+
+  for (size_t i = 0; i < knt_len; i++) {
+    const int hi = from_hex_digit(static_cast<char>(f.data[2 * i]));
+    const int lo = from_hex_digit(static_cast<char>(f.data[2 * i + 1]));
+    if ((hi < 0) || (lo < 0)) {
+      std::fprintf(stderr, "xoodyak-seal: %s: malformed key\n", path);
+      return false;
+    }
+
+    key[i] = static_cast<uint8_t>((hi << 4) | lo);
+  }
+
+  return true;
+}
+
+// Fills buffer with bytes from operating system's CSPRNG
+bool
+random_nonce(uint8_t* const nonce)
+{
+  size_t off = 0ul;
+  while (off < knt_len) {
+    const ssize_t n = ::getrandom(nonce + off, knt_len - off, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    off += static_cast<size_t>(n);
+  }
+
+  return true;
+}
+
+// Output replaces file at its path, so it must not be the input itself
+bool
+same_file(const xoodyak_tool::mapped_file_t& in, const char* const out)
+{
+  struct stat st;
+  return (::stat(out, &st) == 0) && (st.st_dev == in.dev) &&
+         (st.st_ino == in.ino);
+}
+
+int
+seal_file(const uint8_t* const key,
+          const xoodyak_tool::mapped_file_t& in,
+          const char* const out_path,
+          const size_t chunk_len,
+          const size_t jobs)
+{
+  uint8_t nonce[knt_len];
+  if (!random_nonce(nonce)) {
+    std::fprintf(stderr, "xoodyak-seal: getrandom: %s\n", std::strerror(errno));
+    return EXIT_FAILURE;
+  }
+
+  const size_t s_len = xoodyak::chunked_sealed_len(in.len, chunk_len);
+  xoodyak_tool::mapped_out_t out(out_path, s_len, 0644);
+  if (!out.ok()) {
+    std::fprintf(
+      stderr, "xoodyak-seal: %s: %s\n", out_path, std::strerror(out.err));
+    out.discard();
+    return EXIT_FAILURE;
+  }
+
+  xoodyak::seal_chunked(key, nonce, in.data, in.len, out.data, chunk_len, jobs);
+
+  if (!out.commit()) {
+    std::fprintf(
+      stderr, "xoodyak-seal: %s: %s\n", out_path, std::strerror(out.err));
+    out.discard();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int
+open_file(const uint8_t* const key,
+          const xoodyak_tool::mapped_file_t& in,
+          const char* const in_path,
+          const char* const out_path,
+          const size_t jobs)
+{
+  size_t m_len = 0ul, chunks = 0ul;
+  if (!xoodyak::chunked_info(in.data, in.len, &m_len, &chunks)) {
+    std::fprintf(stderr, "xoodyak-seal: %s: not a sealed container\n", in_path);
+    return EXIT_FAILURE;
+  }
+
+  // decrypted payload is readable only by owner
+  xoodyak_tool::mapped_out_t out(out_path, m_len, 0600);
+  if (!out.ok()) {
+    std::fprintf(
+      stderr, "xoodyak-seal: %s: %s\n", out_path, std::strerror(out.err));
+    out.discard();
+    return EXIT_FAILURE;
+  }
+
+  uint8_t empty;
+  uint8_t* const dst = m_len == 0ul ? &empty : out.data;
+
+  if (!xoodyak::open_chunked(key, in.data, in.len, dst, jobs)) {
+    std::fprintf(stderr, "xoodyak-seal: %s: authentication failed\n", in_path);
+    out.discard();
+    return EXIT_FAILURE;
+  }
+
+  if (!out.commit()) {
+    std::fprintf(
+      stderr, "xoodyak-seal: %s: %s\n", out_path, std::strerror(out.err));
+    out.discard();
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int
+main(int argc, char** argv)
+{
+  const char* key_path = nullptr;
+  const char* paths[2]{};
+  size_t n_paths = 0ul;
+  bool decrypt = false;
+  size_t jobs = 0ul, chunk_len = xoodyak::CHUNKED_CHUNK_LEN;
+
+  for (int i = 1; i < argc; i++) {
+    const char* const arg = argv[i];
+    const bool has_val = i + 1 < argc;
+
+    if ((arg[0] != '-') || (arg[1] == '\0')) {
+      if (n_paths == 2) {
+        usage();
+        return EXIT_FAILURE;
+      }
+
+      paths[n_paths++] = arg;
+    } else if (!std::strcmp(arg, "-d")) {
+      decrypt = true;
+    } else if (!std::strcmp(arg, "-k") && has_val) {
+      key_path = argv[++i];
+    } else if ((arg[1] == 'j') || (arg[1] == 's')) {
+      if ((arg[2] == '\0') && !has_val) {
+        usage();
+        return EXIT_FAILURE;
+      }
+
+      const char* const val = arg[2] != '\0' ? arg + 2 : argv[++i];
+
+      char* end = nullptr;
+      const size_t v = std::strtoul(val, &end, 10);
+
+      if ((end == val) || (*end != '\0')) {
+        usage();
+        return EXIT_FAILURE;
+      }
+
+      (arg[1] == 'j' ? jobs : chunk_len) = v;
+    } else {
+      usage();
+      return (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help"))
+               ? EXIT_SUCCESS
+               : EXIT_FAILURE;
+    }
+  }
+
+  if ((key_path == nullptr) || (n_paths != 2) || (chunk_len == 0ul)) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  uint8_t key[knt_len];
+  if (!read_key(key_path, key)) {
+    return EXIT_FAILURE;
+  }
+
+  const xoodyak_tool::mapped_file_t in(paths[0]);
+  if (!in.ok()) {
+    std::fprintf(
+      stderr, "xoodyak-seal: %s: %s\n", paths[0], std::strerror(in.err));
+    return EXIT_FAILURE;
+  }
+
+  if (same_file(in, paths[1])) {
+    std::fprintf(stderr,
+                 "xoodyak-seal: %s: input and output are same file\n",
+                 paths[1]);
+    return EXIT_FAILURE;
+  }
+
+  const int status = decrypt ? open_file(key, in, paths[0], paths[1], jobs)
+                             : seal_file(key, in, paths[1], chunk_len, jobs);
+
+  std::memset(key, 0, knt_len);
+  return status;
+}
@@ -0,0 +1,410 @@
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+#include "xoodyak.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Xoodyak checksum tool, printing ( or checking ) Xoodyak digests of files, in
+// the same format as `sha256sum` does i.e. `<hex digest>  <file name>`, while
+// hashing many files concurrently, across all available cores. Files are
+// memory-mapped, so their pages are hashed straight out of page cache.
+//
+// Compile it with
+//
+// make tools
+//
+// Usage
+//
+// xoodyak-sum [-j N] [FILE]...             print digests
+// xoodyak-sum -c [-j N] [--quiet] [FILE]... check digests listed in FILE(s)
+
+namespace {
+
+// Digest ( or error ), computed for a single input file
+struct result_t
+{
+  uint8_t digest[xoodyak::DIGEST_LEN];
+  int err;
+};
+
+// Single line of checksum file, naming a file and its expected digest
+struct entry_t
+{
+  std::string name;
+  uint8_t digest[xoodyak::DIGEST_LEN];
+};
+
+void
+usage()
+{
+  std::fputs("Usage: xoodyak-sum [-c] [-j N] [--quiet] [FILE]...\n"
+             "Print or check Xoodyak ( 256 -bit ) digests.\n"
+             "With no FILE, or when FILE is -, read standard input.\n\n"
+             "  -c, --check  read digests from FILE(s) and check them\n"
+             "  -j N         hash N files concurrently ( default: all cores )\n"
+             "      --quiet  don't print OK for each verified file\n",
+             stderr);
+}
+
+// Hashes given file, using memory-mapped contents
+void
+hash_file(const char* const path, result_t* const res)
+{
+  const xoodyak_tool::mapped_file_t f(path);
+
+  res->err = f.err;
+  if (f.ok()) {
+    xoodyak::hash(f.data, f.len, res->digest);
+  }
+}
+
+// Whether given file name denotes standard input
+bool
+is_stdin(const char* const path)
+{
+  return (path[0] == '-') && (path[1] == '\0');
+}
+
+// Hashes all given files on `jobs` worker threads, calling `emit(i)` for each
+// of them, in input order, as soon as all preceding ones are hashed, so that
+// output streams, instead of appearing only at the end.
+//
+// Standard input can be read only once, so all "-" entries are hashed upfront,
+// one after another, in input order, on calling thread ( first one consumes
+// whole input, while rest of them see end-of-file, same as `sha256sum` does ),
+// instead of letting worker threads read it concurrently.
+template<typename name_fn_t, typename emit_fn_t>
+void
+hash_files(const size_t n,
+           const size_t jobs,
+           name_fn_t&& name,
+           std::vector<result_t>& res,
+           emit_fn_t&& emit)
+{
+  std::vector<uint8_t> done(n);
+  size_t next = 0ul;
+  std::mutex lock;
+
+  res.resize(n);
+
+  for (size_t i = 0; i < n; i++) {
+    if (is_stdin(name(i))) {
+      hash_file(name(i), &res[i]);
+      done[i] = 1;
+    }
+  }
+  while ((next < n) && done[next]) {
+    emit(next++);
+  }
+
+  xoodyak_utils::parallel_for(n, 1, jobs, [&](size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
+      if (is_stdin(name(i))) {
+        continue;
+      }
+
+      hash_file(name(i), &res[i]);
+
+      std::lock_guard<std::mutex> guard(lock);
+
+      done[i] = 1;
+      while ((next < n) && done[next]) {
+        emit(next++);
+      }
+    }
+  });
+}
+
+// File names holding backslash or new line are escaped ( and their lines are
+// prefixed with backslash ), same as `sha256sum` does
+bool
+needs_escape(const std::string& name)
+{
+  return name.find_first_of("\\\n") != std::string::npos;
+}
+
+std::string
+escape(const std::string& name)
+{
+  std::string s;
+  for (const char c : name) {
+    if (c == '\\') {
+      s += "\\\\";
+    } else if (c == '\n') {
+      s += "\\n";
+    } else {
+      s += c;
+    }
+  }
+
+  return s;
+}
+
+bool
+unescape(const std::string& name, std::string* const out)
+{
+  out->clear();
+  for (size_t i = 0; i < name.size(); i++) {
+    if (name[i] != '\\') {
+      *out += name[i];
+      continue;
+    }
+
+    if (++i == name.size()) {
+      return false;
+    }
+
+    if (name[i] == '\\') {
+      *out += '\\';
+    } else if (name[i] == 'n') {
+      *out += '\n';
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int
+from_hex_digit(const char c)
+{
+  if ((c >= '0') && (c <= '9')) {
+    return c - '0';
+  }
+  if ((c >= 'a') && (c <= 'f')) {
+    return c - 'a' + 10;
+  }
+  if ((c >= 'A') && (c <= 'F')) {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+
+// Parses `[\]<hex digest> <space or *><file name>` line of checksum file
+bool
+parse_line(std::string line, entry_t* const e)
+{
+  constexpr size_t hex_len = xoodyak::DIGEST_LEN * 2;
+
+  if (!line.empty() && (line.back() == '\r')) {
+    line.pop_back();
+  }
+
+  const bool escaped = !line.empty() && (line[0] == '\\');
+  const size_t off = static_cast<size_t>(escaped);
+
+  if ((line.size() < off + hex_len + 3) || (line[off + hex_len] != ' ') ||
+      ((line[off + hex_len + 1] != ' ') && (line[off + hex_len + 1] != '*'))) {
+    return false;
+  }
+
+  for (size_t i = 0; i < xoodyak::DIGEST_LEN; i++) {
+    const int hi = from_hex_digit(line[off + 2 * i]);
+    const int lo = from_hex_digit(line[off + 2 * i + 1]);
+    if ((hi < 0) || (lo < 0)) {
+      return false;
+    }
+
+    e->digest[i] = static_cast<uint8_t>((hi << 4) | lo);
+  }
+
+  const std::string name = line.substr(off + hex_len + 2);
+  if (escaped) {
+    return unescape(name, &e->name);
+  }
+
+  e->name = name;
+  return true;
+}
+
+// Reads all lines of checksum file, appending well-formed entries, returning
+// # -of improperly formatted lines, or -1, if file can't be read
+long
+read_entries(const char* const path, std::vector<entry_t>& entries)
+{
+  const xoodyak_tool::mapped_file_t f(path);
+  if (!f.ok()) {
+    std::fprintf(stderr, "xoodyak-sum: %s: %s\n", path, std::strerror(f.err));
+    return -1;
+  }
+
+  const char* const text = reinterpret_cast<const char*>(f.data);
+  long bad = 0;
+
+  size_t off = 0ul;
+  while (off < f.len) {
+    const char* const nl =
+      static_cast<const char*>(std::memchr(text + off, '\n', f.len - off));
+    const size_t end = nl == nullptr ? f.len : static_cast<size_t>(nl - text);
+
+    entry_t e;
+    if (end > off) {
+      if (parse_line(std::string(text + off, end - off), &e)) {
+        entries.push_back(std::move(e));
+      } else {
+        bad++;
+      }
+    }
+
+    off = end + 1;
+  }
+
+  return bad;
+}
+
+int
+print_digests(const std::vector<const char*>& files, const size_t jobs)
+{
+  std::vector<result_t> res;
+  int status = EXIT_SUCCESS;
+
+  hash_files(
+    files.size(),
+    jobs,
+    [&](const size_t i) { return files[i]; },
+    res,
+    [&](const size_t i) {
+      if (res[i].err != 0) {
+        std::fprintf(
+          stderr, "xoodyak-sum: %s: %s\n", files[i], std::strerror(res[i].err));
+        status = EXIT_FAILURE;
+        return;
+      }
+
+      const std::string name(files[i]);
+      const std::string hex =
+        xoodyak_utils::to_hex(res[i].digest, xoodyak::DIGEST_LEN);
+
+      if (needs_escape(name)) {
+        std::printf("\\%s  %s\n", hex.c_str(), escape(name).c_str());
+      } else {
+        std::printf("%s  %s\n", hex.c_str(), name.c_str());
+      }
+    });
+
+  return status;
+}
+
+int
+check_digests(const std::vector<const char*>& files,
+              const size_t jobs,
+              const bool quiet)
+{
+  std::vector<entry_t> entries;
+  long bad_lines = 0;
+  bool read_err = false;
+
+  for (const char* const f : files) {
+    const long bad = read_entries(f, entries);
+    if (bad < 0) {
+      read_err = true;
+    } else {
+      bad_lines += bad;
+    }
+  }
+
+  std::vector<result_t> res;
+  size_t failed = 0ul, unreadable = 0ul;
+
+  hash_files(
+    entries.size(),
+    jobs,
+    [&](const size_t i) { return entries[i].name.c_str(); },
+    res,
+    [&](const size_t i) {
+      const char* const name = entries[i].name.c_str();
+
+      if (res[i].err != 0) {
+        std::fprintf(
+          stderr, "xoodyak-sum: %s: %s\n", name, std::strerror(res[i].err));
+        std::printf("%s: FAILED open or read\n", name);
+        unreadable++;
+        return;
+      }
+
+      if (std::memcmp(res[i].digest, entries[i].digest, xoodyak::DIGEST_LEN)) {
+        std::printf("%s: FAILED\n", name);
+        failed++;
+      } else if (!quiet) {
+        std::printf("%s: OK\n", name);
+      }
+    });
+
+  std::fflush(stdout);
+
+  if (bad_lines > 0) {
+    std::fprintf(stderr,
+                 "xoodyak-sum: WARNING: %ld line%s improperly formatted\n",
+                 bad_lines,
+                 bad_lines == 1 ? " is" : "s are");
+  }
+  if (unreadable > 0) {
+    std::fprintf(stderr,
+                 "xoodyak-sum: WARNING: %zu listed file%s could not be read\n",
+                 unreadable,
+                 unreadable == 1 ? "" : "s");
+  }
+  if (failed > 0) {
+    std::fprintf(stderr,
+                 "xoodyak-sum: WARNING: %zu computed checksum%s did NOT "
+                 "match\n",
+                 failed,
+                 failed == 1 ? "" : "s");
+  }
+
+  const bool ok = !read_err && (failed == 0) && (unreadable == 0) &&
+                  (!entries.empty() || (bad_lines == 0));
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+}
+
+int
+main(int argc, char** argv)
+{
+  std::vector<const char*> files;
+  bool check = false, quiet = false, no_opts = false;
+  size_t jobs = 0ul;
+
+  for (int i = 1; i < argc; i++) {
+    const char* const arg = argv[i];
+
+    if (no_opts || (arg[0] != '-') || (arg[1] == '\0')) {
+      files.push_back(arg);
+    } else if (!std::strcmp(arg, "--")) {
+      no_opts = true;
+    } else if (!std::strcmp(arg, "-c") || !std::strcmp(arg, "--check")) {
+      check = true;
+    } else if (!std::strcmp(arg, "--quiet")) {
+      quiet = true;
+    } else if (!std::strncmp(arg, "-j", 2) &&
+               ((arg[2] != '\0') || (i + 1 < argc))) {
+      const char* const val = arg[2] != '\0' ? arg + 2 : argv[++i];
+
+      char* end = nullptr;
+      jobs = std::strtoul(val, &end, 10);
+
+      if ((end == val) || (*end != '\0')) {
+        usage();
+        return EXIT_FAILURE;
+      }
+    } else {
+      usage();
+      return (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help"))
+               ? EXIT_SUCCESS
+               : EXIT_FAILURE;
+    }
+  }
+
+  if (files.empty()) {
+    files.push_back("-");
+  }
+
+  return check ? check_digests(files, jobs, quiet) : print_digests(files, jobs);
+}
@@ -2,6 +2,9 @@
 
 import xoodyak as xdk
 import numpy as np
+import mmap
+import os
+import pytest
 
 u8 = np.uint8
 
@@ -126,5 +129,173 @@ def test_aead_kat():
     print(f"[test] passed {count} -many Xoodyak KAT(s)")
 
 
+@pytest.mark.skipif(xdk.NATIVE is None, reason="use `make pylib` to build it")
+def test_native_buffers():
+    """
+    Test that native extension module takes inputs as any buffer protocol
+    object, writes outputs into caller-provided buffers ( possibly in-place )
+    and computes same digest/ cipher text/ tag, as it does on bytes objects
+    """
+    for m_len in [0, 1, 31, 44, 100, 4096, 65537]:
+        key, nonce, data, text = (os.urandom(n) for n in (16, 16, 33, m_len))
+
+        digest = xdk.hash(text)
+        cipher, tag = xdk.encrypt(key, nonce, data, text)
+
+        for conv in (bytearray, memoryview, lambda b: np.frombuffer(b, dtype=u8)):
+            assert xdk.hash(conv(text)) == digest
+            assert xdk.encrypt(conv(key), nonce, conv(data), conv(text)) == (
+                cipher,
+                tag,
+            )
+
+        if m_len > 0:
+            with mmap.mmap(-1, m_len) as mm:
+                mm.write(text)
+                assert xdk.hash(mm) == digest
+
+        # caller-provided output buffers
+        out = bytearray(32)
+        assert xdk.hash(text, out) is out and out == digest
+
+        enc, tag_ = bytearray(m_len), np.zeros(16, dtype=u8)
+        xdk.encrypt(key, nonce, data, text, enc, tag_)
+        assert enc == cipher and tag_.tobytes() == tag
+
+        dec = bytearray(m_len)
+        flag, dec_ = xdk.decrypt(key, nonce, tag, data, cipher, dec)
+        assert flag and dec_ is dec and dec == text
+
+        # in-place encryption/ decryption
+        buf = bytearray(text)
+        xdk.encrypt(key, nonce, data, buf, buf, tag_)
+        assert buf == cipher and tag_.tobytes() == tag
+
+        flag, _ = xdk.decrypt(key, nonce, tag, data, buf, buf)
+        assert flag and buf == text
+
+        # failed verification zeroes plain text
+        bad = bytes([tag[0] ^ 1]) + tag[1:]
+        flag, dec_ = xdk.decrypt(key, nonce, bad, data, cipher, dec)
+        assert not flag and dec == bytes(m_len)
+
+        # malformed arguments are rejected
+        with pytest.raises(ValueError):
+            xdk.encrypt(key[:15], nonce, data, text)
+        with pytest.raises(ValueError):
+            xdk.hash(text, bytearray(31))
+        with pytest.raises(BufferError):
+            xdk.hash(text, bytes(32))
+        if m_len > 1:
+            mv = memoryview(bytearray(m_len + 1))
+            with pytest.raises(ValueError):
+                xdk.encrypt(key, nonce, data, mv[1:], mv[:-1])
+
+        # no output may overlap with any input ( or other output ), except
+        # in-place cipher/ plain text
+        if m_len >= 16:
+            mv = memoryview(bytearray(cipher))
+            aliased = [
+                lambda: xdk.encrypt(mv[:16], nonce, data, text, None, mv[:16]),
+                lambda: xdk.encrypt(key, nonce, data, mv, None, mv[:16]),
+                lambda: xdk.encrypt(key, nonce, data, mv, mv, mv[:16]),
+                lambda: xdk.encrypt(key, nonce, mv, text, mv),
+                lambda: xdk.decrypt(mv[:16], nonce, tag, data, cipher, mv),
+                lambda: xdk.decrypt(key, nonce, mv[:16], data, cipher, mv),
+                lambda: xdk.decrypt(key, nonce, tag, mv, cipher, mv),
+                lambda: xdk.decrypt(key, mv[-16:], tag, data, mv, mv),
+            ]
+            for fn in aliased:
+                with pytest.raises(ValueError, match="overlaps"):
+                    fn()
+
+    mv = memoryview(bytearray(64))
+    with pytest.raises(ValueError, match="overlaps"):
+        xdk.hash(mv, mv[32:])
+
+
+@pytest.mark.skipif(xdk.SO_LIB is None, reason="use `make lib` to build it")
+def test_batch():
+    """
+    Test that batched routines of shared library object compute same digests/
+    cipher texts/ tags/ plain texts, as single message routines do, for many
+    messages of different lengths, packed into contiguous buffers
+    """
+    rng = np.random.default_rng()
+    n = 700
+
+    lens = rng.integers(0, 300, n)
+    lens[: n // 2] = 64  # enough equal length messages for multi-state hashing
+    off = np.concatenate(([0], np.cumsum(lens)[:-1]))
+    buf = os.urandom(int(lens.sum()))
+
+    for n_threads in [1, 3, 0]:
+        digests = xdk.hash_batch(buf, off, lens, n_threads)
+        for i in range(n):
+            assert digests[i].tobytes() == xdk.hash(buf[off[i] : off[i] + lens[i]])
+
+    dt_lens = rng.integers(0, 100, n)
+    dt_off = np.concatenate(([0], np.cumsum(dt_lens)[:-1]))
+    data = os.urandom(int(dt_lens.sum()))
+    keys, nonces = os.urandom(n * 16), os.urandom(n * 16)
+
+    cipher, tags = xdk.encrypt_batch(keys, nonces, data, dt_off, dt_lens, buf, off, lens)
+
+    for i in range(n):
+        key, nonce = keys[i * 16 : (i + 1) * 16], nonces[i * 16 : (i + 1) * 16]
+        ad = data[dt_off[i] : dt_off[i] + dt_lens[i]]
+        txt = buf[off[i] : off[i] + lens[i]]
+
+        enc, tag = xdk.encrypt(key, nonce, ad, txt)
+        assert cipher[off[i] : off[i] + lens[i]].tobytes() == enc
+        assert tags[i].tobytes() == tag
+
+    tags[n // 3, 0] ^= 1
+    flags, text = xdk.decrypt_batch(
+        keys, nonces, tags, data, dt_off, dt_lens, cipher, off, lens, 2
+    )
+
+    for i in range(n):
+        txt = buf[off[i] : off[i] + lens[i]] if i != n // 3 else bytes(lens[i])
+        assert flags[i] == (i != n // 3)
+        assert text[off[i] : off[i] + lens[i]].tobytes() == txt
+
+
+@pytest.mark.skipif(xdk.SO_LIB is None, reason="use `make lib` to build it")
+def test_batch_bounds():
+    """
+    Test that batched routines reject ( offset, length ) records, which don't
+    lie within their buffers, including those whose sum wraps around, and
+    negative ones, instead of reading/ writing out of bounds
+    """
+    buf = bytes(64)
+    key = bytes(16)
+
+    bad = [
+        ([2**64 - 2**20], [2**20 + 1]),  # off + len wraps around to 1
+        ([0], [65]),
+        ([65], [0]),
+        ([-1], [1]),
+        ([0], [-1]),
+    ]
+
+    for off, lens in bad:
+        with pytest.raises(ValueError):
+            xdk.hash_batch(buf, off, lens)
+        with pytest.raises(ValueError):
+            xdk.encrypt_batch(key, key, buf, [0], [0], buf, off, lens)
+        with pytest.raises(ValueError):
+            xdk.encrypt_batch(key, key, buf, off, lens, buf, [0], [0])
+        with pytest.raises(ValueError):
+            xdk.decrypt_batch(key, key, key, buf, [0], [0], buf, off, lens)
+        with pytest.raises(ValueError):
+            xdk.decrypt_batch(key, key, key, buf, off, lens, buf, [0], [0])
+
+    # records ending exactly at end of buffer are fine
+    digests = xdk.hash_batch(buf, [64, 0], [0, 64])
+    assert digests[0].tobytes() == xdk.hash(b"")
+    assert digests[1].tobytes() == xdk.hash(buf)
+
+
 if __name__ == "__main__":
     print("Run Xoodak Known Answer Tests using `pytest` !")
@@ -2,9 +2,16 @@
 
 """
   Before using `xoodyak` library module, make sure you've run
-  `make lib` and generated shared library object, which is loaded
-  here; then all function calls are forwarded to respective C++
-  implementation, executed on host CPU.
+  `make pylib` ( or `make lib` ) and generated native extension module
+  ( or shared library object ), which is loaded here; then all function
+  calls are forwarded to respective C++ implementation, executed on
+  host CPU.
+
+  Native extension module `_xoodyak` is preferred, when it's importable,
+  as it takes inputs as any buffer protocol object ( bytes, bytearray,
+  memoryview, mmap, numpy array ), without copying them, can write
+  outputs into caller-provided buffers and releases GIL, while
+  processing long inputs. Otherwise calls go through ctypes.
 
   Author: Anjan Roy <hello@itzmeanjan.in>
   
@@ -13,21 +20,62 @@
 
 import ctypes as ct
 from typing import Tuple
-import numpy as np
 from posixpath import exists, abspath
 
+try:
+    import _xoodyak as NATIVE
+except ImportError:
+    NATIVE = None
+
 # shared library object path
 SO_PATH: str = abspath("../libxoodyak.so")
-# enforce presence of shared library object
-assert exists(SO_PATH), "Use `make lib` to generate shared library object !"
-# shared library object
-SO_LIB: ct.CDLL = ct.CDLL(SO_PATH)
 
-# prepare data types for input/ output of C++ functions
-u8 = np.uint8
-len_t = ct.c_size_t
-uint8_tp = np.ctypeslib.ndpointer(dtype=u8, ndim=1, flags="CONTIGUOUS")
-bool_t = ct.c_bool
+if NATIVE is None:
+    # enforce presence of shared library object
+    assert exists(SO_PATH), "Use `make lib` to generate shared library object !"
+
+# shared library object, also needed for batched routines
+SO_LIB = ct.CDLL(SO_PATH) if exists(SO_PATH) else None
+
+if SO_LIB is not None:
+    import numpy as np
+
+    # prepare data types for input/ output of C++ functions
+    u8 = np.uint8
+    len_t = ct.c_size_t
+    uint8_tp = np.ctypeslib.ndpointer(dtype=u8, ndim=1, flags="CONTIGUOUS")
+    lens_tp = np.ctypeslib.ndpointer(dtype=np.uintp, ndim=1, flags="CONTIGUOUS")
+    bools_tp = np.ctypeslib.ndpointer(dtype=np.bool_, ndim=1, flags="CONTIGUOUS")
+    bool_t = ct.c_bool
+
+    # declare signatures of C++ functions, once
+    SO_LIB.hash.argtypes = [uint8_tp, len_t, uint8_tp]
+    SO_LIB.encrypt.argtypes = [
+        uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp
+    ]
+    SO_LIB.decrypt.argtypes = [
+        uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t
+    ]
+    SO_LIB.decrypt.restype = bool_t
+
+    SO_LIB.hash_batch.argtypes = [
+        uint8_tp, len_t, lens_tp, lens_tp, len_t, uint8_tp, len_t
+    ]
+    SO_LIB.hash_batch.restype = bool_t
+    SO_LIB.encrypt_batch.argtypes = [
+        uint8_tp, uint8_tp,
+        uint8_tp, len_t, lens_tp, lens_tp,
+        uint8_tp, len_t, lens_tp, lens_tp,
+        uint8_tp, uint8_tp, len_t, len_t
+    ]
+    SO_LIB.encrypt_batch.restype = bool_t
+    SO_LIB.decrypt_batch.argtypes = [
+        uint8_tp, uint8_tp, uint8_tp,
+        uint8_tp, len_t, lens_tp, lens_tp,
+        uint8_tp, len_t, lens_tp, lens_tp,
+        uint8_tp, bools_tp, len_t, len_t
+    ]
+    SO_LIB.decrypt_batch.restype = bool_t
 
 
 def hash(msg: bytes) -> bytes:
@@ -39,9 +87,6 @@ def hash(msg: bytes) -> bytes:
     msg_ = np.frombuffer(msg, dtype=u8)
     digest = np.empty(32, dtype=u8)
 
-    args = [uint8_tp, len_t, uint8_tp]
-    SO_LIB.hash.argtypes = args
-
     SO_LIB.hash(msg_, m_len, digest)
 
     digest_ = digest.tobytes()
@@ -70,9 +115,6 @@ def encrypt(key: bytes, nonce: bytes, data: bytes, text: bytes) -> Tuple[bytes,
     enc = np.empty(t_len, dtype=u8)
     tag = np.empty(16, dtype=u8)
 
-    args = [uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp]
-    SO_LIB.encrypt.argtypes = args
-
     SO_LIB.encrypt(key_, nonce_, data_, d_len, text_, enc, t_len, tag)
 
     enc_ = enc.tobytes()
@@ -91,7 +133,7 @@ def decrypt(
     """
     k_len = len(key)
     n_len = len(nonce)
-    t_len = len(nonce)
+    t_len = len(tag)
     dt_len = len(data)
     ct_len = len(enc)
 
@@ -106,10 +148,6 @@ def decrypt(
     enc_ = np.frombuffer(enc, dtype=u8)
     dec = np.empty(ct_len, dtype=u8)
 
-    args = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t]
-    SO_LIB.decrypt.argtypes = args
-    SO_LIB.decrypt.restypes = bool_t
-
     f = SO_LIB.decrypt(key_, nonce_, tag_, data_, dt_len, enc_, dec, ct_len)
 
     dec_ = dec.tobytes()
@@ -117,5 +155,142 @@ def decrypt(
     return f, dec_
 
 
+def _u8(buf) -> "np.ndarray":
+    """
+    Views any buffer protocol object as flat uint8 array, without copying it
+    """
+    return np.frombuffer(buf, dtype=u8)
+
+
+def _lens(arr) -> "np.ndarray":
+    """
+    Converts offsets/ lengths into contiguous `size_t` array ( copying them only
+    when they're not already of that type ), rejecting anything but integers in
+    [0, 2^64), before casting, so that negative ones don't wrap around
+    """
+    a = np.asarray(arr)
+    if a.size == 0:
+        return np.empty(0, dtype=np.uintp)
+    if a.ndim != 1 or not np.issubdtype(a.dtype, np.integer):
+        raise ValueError("offsets/ lengths must be 1-D array of integers")
+    if np.issubdtype(a.dtype, np.signedinteger) and bool((a < 0).any()):
+        raise ValueError("offsets/ lengths must be non-negative")
+    return np.ascontiguousarray(a, dtype=np.uintp)
+
+
+def _check_records(off: "np.ndarray", lens: "np.ndarray", buf_len: int):
+    """
+    Checks that each ( offset, length ) record lies within buffer of `buf_len`
+    -bytes, as `off[i] <= buf_len and lens[i] <= buf_len - off[i]`, so that sum
+    of them is never formed, which could wrap around
+    """
+    ok = off <= buf_len
+    ok[ok] = lens[ok] <= np.uintp(buf_len) - off[ok]
+    if not bool(ok.all()):
+        raise ValueError("( offset, length ) record out of bounds")
+
+
+def hash_batch(msgs, offsets, lengths, n_threads: int = 0) -> "np.ndarray":
+    """
+    Given n messages, as ( offset, length ) pairs into single contiguous buffer,
+    this function computes 32 -bytes Xoodyak digest of each of them, in a single
+    call into shared library object, on `n_threads` worker threads ( 0 denotes
+    all available ones ), returning n x 32 uint8 array of digests
+    """
+    off, lens = _lens(offsets), _lens(lengths)
+    n = len(off)
+    if len(lens) != n:
+        raise ValueError("need as many lengths as offsets")
+
+    msgs_ = _u8(msgs)
+    _check_records(off, lens, len(msgs_))
+
+    digests = np.empty(n * 32, dtype=u8)
+    if not SO_LIB.hash_batch(msgs_, len(msgs_), off, lens, n, digests, n_threads):
+        raise ValueError("( offset, length ) record out of bounds")
+
+    return digests.reshape(n, 32)
+
+
+def encrypt_batch(
+    keys, nonces, data, dt_off, dt_len, text, ct_off, ct_len, n_threads: int = 0
+) -> Tuple["np.ndarray", "np.ndarray"]:
+    """
+    Given n messages, each with its own 16 -bytes key & nonce ( back to back in
+    `keys`/ `nonces` ), associated data & plain text, as ( offset, length ) pairs
+    into two contiguous buffers, this function encrypts all of them, in a single
+    call into shared library object, returning cipher texts ( laid out same as
+    plain texts ) & n x 16 uint8 array of authentication tags ( in order )
+    """
+    dt_off, dt_len = _lens(dt_off), _lens(dt_len)
+    ct_off, ct_len = _lens(ct_off), _lens(ct_len)
+    keys_, nonces_, data_, text_ = _u8(keys), _u8(nonces), _u8(data), _u8(text)
+
+    n = len(ct_off)
+    if len(keys_) != n * 16 or len(nonces_) != n * 16:
+        raise ValueError("need n keys & nonces")
+    if not len(dt_off) == len(dt_len) == len(ct_len) == n:
+        raise ValueError("need n lengths")
+    _check_records(dt_off, dt_len, len(data_))
+    _check_records(ct_off, ct_len, len(text_))
+
+    cipher = np.zeros(len(text_), dtype=u8)
+    tags = np.empty(n * 16, dtype=u8)
+
+    if not SO_LIB.encrypt_batch(
+        keys_, nonces_, data_, len(data_), dt_off, dt_len,
+        text_, len(text_), ct_off, ct_len, cipher, tags, n, n_threads
+    ):
+        raise ValueError("( offset, length ) record out of bounds")
+
+    return cipher, tags.reshape(n, 16)
+
+
+def decrypt_batch(
+    keys, nonces, tags, data, dt_off, dt_len, cipher, ct_off, ct_len,
+    n_threads: int = 0
+) -> Tuple["np.ndarray", "np.ndarray"]:
+    """
+    Given n messages, each with its own 16 -bytes key, nonce & tag ( back to back
+    in `keys`/ `nonces`/ `tags` ), associated data & cipher text, as ( offset,
+    length ) pairs into two contiguous buffers, this function decrypts all of
+    them, in a single call into shared library object, returning n boolean
+    verification flags & plain texts ( laid out same as cipher texts ), where
+    plain text of each message, which fails verification, is zeroed
+    """
+    dt_off, dt_len = _lens(dt_off), _lens(dt_len)
+    ct_off, ct_len = _lens(ct_off), _lens(ct_len)
+    keys_, nonces_, tags_ = _u8(keys), _u8(nonces), _u8(tags)
+    data_, cipher_ = _u8(data), _u8(cipher)
+
+    n = len(ct_off)
+    if len(keys_) != n * 16 or len(nonces_) != n * 16:
+        raise ValueError("need n keys & nonces")
+    if len(tags_) != n * 16:
+        raise ValueError("need n tags")
+    if not len(dt_off) == len(dt_len) == len(ct_len) == n:
+        raise ValueError("need n lengths")
+    _check_records(dt_off, dt_len, len(data_))
+    _check_records(ct_off, ct_len, len(cipher_))
+
+    text = np.zeros(len(cipher_), dtype=u8)
+    flags = np.empty(n, dtype=np.bool_)
+
+    SO_LIB.decrypt_batch(
+        keys_, nonces_, tags_, data_, len(data_), dt_off, dt_len,
+        cipher_, len(cipher_), ct_off, ct_len, text, flags, n, n_threads
+    )
+
+    return flags, text
+
+
+if NATIVE is not None:
+    # zero-copy native routines, with same signatures as above ( along with
+    # optional trailing output buffers ), see `xoodyak_ext.cpp`
+    hash = NATIVE.hash
+    encrypt = NATIVE.encrypt
+    decrypt = NATIVE.decrypt
+
+
 if __name__ == "__main__":
     print("Use `xoodyak` as library module !")
@@ -0,0 +1,373 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "xoodyak.hpp"
+#include <initializer_list>
+
+// Native CPython extension module ( `_xoodyak` ), on top of underlying C++
+// implementation of Xoodyak cryptographic suite, which takes inputs as any
+// object supporting buffer protocol ( say bytes, bytearray, memoryview, mmap or
+// contiguous numpy array ), without copying them, while outputs are written
+// either into newly created bytes objects or into caller-provided writable
+// buffers. GIL is released, while processing long enough inputs, so that other
+// Python threads can run meanwhile.
+//
+// Build it with `make pylib`; `xoodyak.py` prefers it over ctypes wrapper, when
+// it's importable.
+
+namespace {
+
+// Inputs ( in total ) shorter than these many bytes are processed without
+// releasing GIL, as releasing & reacquiring it costs more than hashing/
+// encrypting them
+constexpr size_t GIL_RELEASE_LEN = 2048ul;
+
+// Holds buffer exported by a Python object, releasing it, when going out of
+// scope
+struct buffer_t
+{
+  Py_buffer view{};
+  bool held = false;
+
+  // Requests contiguous ( and writable, if asked for ) buffer from object,
+  // setting Python exception on failure
+  inline bool get(PyObject* const obj, const bool writable)
+  {
+    const int flags = writable ? PyBUF_WRITABLE : PyBUF_SIMPLE;
+    held = PyObject_GetBuffer(obj, &view, flags) == 0;
+    return held;
+  }
+
+  inline ~buffer_t()
+  {
+    if (held) {
+      PyBuffer_Release(&view);
+    }
+  }
+
+  inline uint8_t* data() const { return static_cast<uint8_t*>(view.buf); }
+  inline size_t size() const { return static_cast<size_t>(view.len); }
+};
+
+// Checks that buffer is of expected length, setting `ValueError` otherwise
+bool
+check_len(const buffer_t& b, const size_t len, const char* const what)
+{
+  if (b.size() != len) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s must be %zu -bytes, found %zu -bytes",
+                 what,
+                 len,
+                 b.size());
+    return false;
+  }
+
+  return true;
+}
+
+// Memory region of an input ( or output ) buffer, named in error messages,
+// where `inplace` denotes whether output may be exactly same region
+struct region_t
+{
+  const uint8_t* ptr;
+  size_t len;
+  const char* what;
+  bool inplace = false;
+};
+
+// Output buffer must not overlap with any of given buffers ( all inputs & other
+// outputs ), as underlying routines take them as `__restrict` pointers, except
+// that it may be exactly same as the one marked `inplace`. Sets `ValueError`
+// otherwise.
+bool
+check_disjoint(const region_t out, const std::initializer_list<region_t> bufs)
+{
+  const uintptr_t o = reinterpret_cast<uintptr_t>(out.ptr);
+
+  for (const region_t& b : bufs) {
+    const uintptr_t i = reinterpret_cast<uintptr_t>(b.ptr);
+
+    const bool empty = (out.len == 0) || (b.len == 0);
+    const bool disjoint = (o + out.len <= i) || (i + b.len <= o);
+    const bool same = b.inplace && (o == i) && (out.len == b.len);
+
+    if (!empty && !disjoint && !same) {
+      PyErr_Format(PyExc_ValueError,
+                   "%s buffer overlaps %s buffer",
+                   out.what,
+                   b.what);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Either writable buffer exported by caller-provided object or newly created
+// bytes object, of given length, output is written into
+struct output_t
+{
+  buffer_t buf;
+  PyObject* obj = nullptr;
+  uint8_t* ptr = nullptr;
+
+  inline bool make(PyObject* const dst, const size_t len, const char* const what)
+  {
+    if ((dst != nullptr) && (dst != Py_None)) {
+      if (!buf.get(dst, true) || !check_len(buf, len, what)) {
+        return false;
+      }
+
+      Py_INCREF(dst);
+      obj = dst;
+      ptr = buf.data();
+      return true;
+    }
+
+    obj = PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(len));
+    if (obj == nullptr) {
+      return false;
+    }
+
+    ptr = reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(obj));
+    return true;
+  }
+
+  inline ~output_t() { Py_XDECREF(obj); }
+
+  // Hands over ( owned ) reference of output object to caller
+  inline PyObject* release()
+  {
+    PyObject* const o = obj;
+    obj = nullptr;
+    return o;
+  }
+};
+
+// Checks that # -of positional arguments lies in [lo, hi]
+bool
+check_nargs(const char* const fn,
+            const Py_ssize_t nargs,
+            const Py_ssize_t lo,
+            const Py_ssize_t hi)
+{
+  if ((nargs < lo) || (nargs > hi)) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s() takes %zd to %zd positional arguments, but %zd given",
+                 fn,
+                 lo,
+                 hi,
+                 nargs);
+    return false;
+  }
+
+  return true;
+}
+
+// Runs given callable, after releasing GIL, when input is long enough
+template<typename fn_t>
+void
+run(const size_t len, fn_t&& fn)
+{
+  if (len < GIL_RELEASE_LEN) {
+    fn();
+    return;
+  }
+
+  Py_BEGIN_ALLOW_THREADS fn();
+  Py_END_ALLOW_THREADS
+}
+
+// hash(msg[, out]) -> digest
+//
+// Computes 32 -bytes Xoodyak digest of message, writing it into `out`, when
+// given, otherwise into newly created bytes object.
+PyObject*
+py_hash(PyObject*, PyObject* const* args, const Py_ssize_t nargs)
+{
+  if (!check_nargs("hash", nargs, 1, 2)) {
+    return nullptr;
+  }
+
+  buffer_t msg;
+  output_t out;
+
+  if (!msg.get(args[0], false) ||
+      !out.make(nargs > 1 ? args[1] : nullptr, xoodyak::DIGEST_LEN, "out") ||
+      !check_disjoint({ out.ptr, xoodyak::DIGEST_LEN, "out" },
+                      { { msg.data(), msg.size(), "msg" } })) {
+    return nullptr;
+  }
+
+  uint8_t* const digest = out.ptr;
+  run(msg.size(), [&]() { xoodyak::hash(msg.data(), msg.size(), digest); });
+
+  return out.release();
+}
+
+// encrypt(key, nonce, data, text[, cipher, tag]) -> (cipher, tag)
+//
+// Encrypts plain text, after absorbing associated data, computing cipher text
+// and 16 -bytes authentication tag, writing them into `cipher`/ `tag`, when
+// given ( `cipher` can be same buffer as `text`, while no other output buffer
+// may overlap with any other buffer ), otherwise into newly created bytes
+// objects.
+PyObject*
+py_encrypt(PyObject*, PyObject* const* args, const Py_ssize_t nargs)
+{
+  if (!check_nargs("encrypt", nargs, 4, 6)) {
+    return nullptr;
+  }
+
+  buffer_t key, nonce, data, text;
+  output_t cipher, tag;
+
+  if (!key.get(args[0], false) || !check_len(key, 16, "key") ||
+      !nonce.get(args[1], false) || !check_len(nonce, 16, "nonce") ||
+      !data.get(args[2], false) || !text.get(args[3], false)) {
+    return nullptr;
+  }
+
+  const size_t ct_len = text.size();
+
+  if (!cipher.make(nargs > 4 ? args[4] : nullptr, ct_len, "cipher") ||
+      !tag.make(nargs > 5 ? args[5] : nullptr, 16, "tag")) {
+    return nullptr;
+  }
+
+  const region_t k{ key.data(), 16, "key" };
+  const region_t n{ nonce.data(), 16, "nonce" };
+  const region_t d{ data.data(), data.size(), "data" };
+
+  if (!check_disjoint({ cipher.ptr, ct_len, "cipher" },
+                      { k, n, d, { text.data(), ct_len, "text", true } }) ||
+      !check_disjoint({ tag.ptr, 16, "tag" },
+                      { k,
+                        n,
+                        d,
+                        { text.data(), ct_len, "text" },
+                        { cipher.ptr, ct_len, "cipher" } })) {
+    return nullptr;
+  }
+
+  uint8_t* const enc = cipher.ptr;
+  uint8_t* const t = tag.ptr;
+
+  run(data.size() + ct_len, [&]() {
+    if (enc == text.data()) {
+      xoodyak::encrypt_inplace(
+        key.data(), nonce.data(), data.data(), data.size(), enc, ct_len, t);
+    } else {
+      xoodyak::encrypt(key.data(),
+                       nonce.data(),
+                       data.data(),
+                       data.size(),
+                       text.data(),
+                       enc,
+                       ct_len,
+                       t);
+    }
+  });
+
+  PyObject* const c = cipher.release();
+  PyObject* const g = tag.release();
+  return Py_BuildValue("(NN)", c, g);
+}
+
+// decrypt(key, nonce, tag, data, cipher[, text]) -> (flag, text)
+//
+// Decrypts cipher text, after absorbing associated data, returning boolean
+// verification flag along with plain text, written into `text`, when given
+// ( can be same buffer as `cipher`, but must not overlap with any other
+// buffer ), otherwise into newly created bytes object. If verification fails,
+// plain text is zeroed.
+PyObject*
+py_decrypt(PyObject*, PyObject* const* args, const Py_ssize_t nargs)
+{
+  if (!check_nargs("decrypt", nargs, 5, 6)) {
+    return nullptr;
+  }
+
+  buffer_t key, nonce, tag, data, cipher;
+  output_t text;
+
+  if (!key.get(args[0], false) || !check_len(key, 16, "key") ||
+      !nonce.get(args[1], false) || !check_len(nonce, 16, "nonce") ||
+      !tag.get(args[2], false) || !check_len(tag, 16, "tag") ||
+      !data.get(args[3], false) || !cipher.get(args[4], false)) {
+    return nullptr;
+  }
+
+  const size_t ct_len = cipher.size();
+
+  if (!text.make(nargs > 5 ? args[5] : nullptr, ct_len, "text") ||
+      !check_disjoint({ text.ptr, ct_len, "text" },
+                      { { key.data(), 16, "key" },
+                        { nonce.data(), 16, "nonce" },
+                        { tag.data(), 16, "tag" },
+                        { data.data(), data.size(), "data" },
+                        { cipher.data(), ct_len, "cipher", true } })) {
+    return nullptr;
+  }
+
+  uint8_t* const dec = text.ptr;
+  bool f = false;
+
+  run(data.size() + ct_len, [&]() {
+    if (dec == cipher.data()) {
+      f = xoodyak::decrypt_inplace(key.data(),
+                                   nonce.data(),
+                                   tag.data(),
+                                   data.data(),
+                                   data.size(),
+                                   dec,
+                                   ct_len);
+    } else {
+      f = xoodyak::decrypt(key.data(),
+                           nonce.data(),
+                           tag.data(),
+                           data.data(),
+                           data.size(),
+                           cipher.data(),
+                           dec,
+                           ct_len);
+    }
+  });
+
+  PyObject* const t = text.release();
+  return Py_BuildValue("(NN)", PyBool_FromLong(f), t);
+}
+
+PyMethodDef methods[]{
+  { "hash",
+    reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(py_hash)),
+    METH_FASTCALL,
+    "hash(msg[, out]) -> 32 -bytes Xoodyak digest" },
+  { "encrypt",
+    reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(py_encrypt)),
+    METH_FASTCALL,
+    "encrypt(key, nonce, data, text[, cipher, tag]) -> (cipher, tag)" },
+  { "decrypt",
+    reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(py_decrypt)),
+    METH_FASTCALL,
+    "decrypt(key, nonce, tag, data, cipher[, text]) -> (flag, text)" },
+  { nullptr, nullptr, 0, nullptr }
+};
+
+PyModuleDef module{ PyModuleDef_HEAD_INIT,
+                    "_xoodyak",
+                    "Xoodyak hash & AEAD, on buffer protocol objects",
+                    -1,
+                    methods,
+                    nullptr,
+                    nullptr,
+                    nullptr,
+                    nullptr };
+
+}
+
+PyMODINIT_FUNC
+PyInit__xoodyak()
+{
+  return PyModule_Create(&module);
+}
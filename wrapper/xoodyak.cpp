@@ -1,4 +1,9 @@
+#include "aead_batch.hpp"
+#include "hash_batch.hpp"
+#include "parallel.hpp"
 #include "xoodyak.hpp"
+#include <algorithm>
+#include <vector>
 
 // Thin C wrapper on top of underlying C++ implementation of Xoodyak
 // cryptographic suite, as submitted in NIST LWC competition
@@ -29,6 +34,68 @@ extern "C"
                const uint8_t* const __restrict,
                uint8_t* const __restrict,
                const size_t);
+
+  bool hash_batch(const uint8_t* const __restrict,
+                  const size_t,
+                  const size_t* const __restrict,
+                  const size_t* const __restrict,
+                  const size_t,
+                  uint8_t* const __restrict,
+                  const size_t);
+
+  bool encrypt_batch(const uint8_t* const __restrict,
+                     const uint8_t* const __restrict,
+                     const uint8_t* const __restrict,
+                     const size_t,
+                     const size_t* const __restrict,
+                     const size_t* const __restrict,
+                     const uint8_t* const __restrict,
+                     const size_t,
+                     const size_t* const __restrict,
+                     const size_t* const __restrict,
+                     uint8_t* const __restrict,
+                     uint8_t* const __restrict,
+                     const size_t,
+                     const size_t);
+
+  bool decrypt_batch(const uint8_t* const __restrict,
+                     const uint8_t* const __restrict,
+                     const uint8_t* const __restrict,
+                     const uint8_t* const __restrict,
+                     const size_t,
+                     const size_t* const __restrict,
+                     const size_t* const __restrict,
+                     const uint8_t* const __restrict,
+                     const size_t,
+                     const size_t* const __restrict,
+                     const size_t* const __restrict,
+                     uint8_t* const __restrict,
+                     bool* const __restrict,
+                     const size_t,
+                     const size_t);
+}
+
+// Batched routines split messages into groups of these many, which are handed
+// out to worker threads, one group at a time. Worker threads come from process
+// wide pool ( see `parallel.hpp` ), which is started on first call and reused
+// by following ones.
+constexpr size_t BATCH_GROUP = 256ul;
+
+// Checks that each of n ( offset, length ) records lies within buffer of
+// `buf_len` -bytes, without letting `off[i] + len[i]` wrap around
+static inline bool
+in_bounds(const size_t* const __restrict off,
+          const size_t* const __restrict len,
+          const size_t n,
+          const size_t buf_len)
+{
+  for (size_t i = 0; i < n; i++) {
+    if (off[i] > buf_len || len[i] > buf_len - off[i]) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 // Function definitions
@@ -88,4 +155,150 @@ extern "C"
     f = xoodyak::decrypt(key, nonce, tag, data, dt_len, cipher, text, ct_len);
     return f;
   }
+
+  // Given n messages, as ( offset, length ) pairs into single contiguous
+  // buffer, this function computes 32 -bytes digest of each of them, written
+  // back to back into `digests`, on `n_threads` worker threads ( 0 denotes all
+  // available hardware threads ), each of them hashing equal length messages
+  // using multi-state Xoodoo permutation.
+  //
+  // Produces exactly same digests as n calls to `hash(...)`, while crossing
+  // FFI boundary only once. Returns false, without touching `digests`, if any
+  // message doesn't lie within `msgs`.
+  bool hash_batch(
+    const uint8_t* const __restrict msgs, // messages, back to back
+    const size_t m_len,                   // len(msgs) | >= 0
+    const size_t* const __restrict off,   // n offsets into msgs
+    const size_t* const __restrict len,   // n message lengths
+    const size_t n,                       // # -of messages
+    uint8_t* const __restrict digests,    // n * 32 -bytes digests
+    const size_t n_threads                // # -of worker threads
+  )
+  {
+    if (!in_bounds(off, len, n, m_len)) {
+      return false;
+    }
+
+    std::vector<const uint8_t*> msg(n);
+    std::vector<uint8_t*> out(n);
+
+    for (size_t i = 0; i < n; i++) {
+      msg[i] = msgs + off[i];
+      out[i] = digests + i * xoodyak::DIGEST_LEN;
+    }
+
+    xoodyak_utils::parallel_for(
+      n, BATCH_GROUP, n_threads, [&](const size_t from, const size_t to) {
+        xoodyak::hash_batch(
+          msg.data() + from, len + from, out.data() + from, to - from);
+      });
+
+    return true;
+  }
+
+  // Given n messages, each with its own 16 -bytes key & nonce ( back to back
+  // in `keys`/ `nonces` ) and associated data & plain text, as ( offset,
+  // length ) pairs into two contiguous buffers, this function encrypts all of
+  // them, on `n_threads` worker threads ( 0 denotes all available hardware
+  // threads ), each of them keeping 16 ( with AVX-512, otherwise 8 ) messages
+  // in flight, using multi-state Xoodoo permutation.
+  //
+  // Cipher text of i -th message is written to `cipher`, at same offset, as its
+  // plain text is found at, in `text`, while its 16 -bytes tag is written to
+  // `tags`, at offset i * 16. Returns false, without touching `cipher`/
+  // `tags`, if any associated data ( or plain text ) doesn't lie within `data`
+  // ( or `text` ).
+  bool encrypt_batch(
+    const uint8_t* const __restrict keys,   // n * 16 -bytes secret keys
+    const uint8_t* const __restrict nonces, // n * 16 -bytes nonces
+    const uint8_t* const __restrict data,   // associated data, back to back
+    const size_t d_len,                     // len(data) | >= 0
+    const size_t* const __restrict dt_off,  // n offsets into data
+    const size_t* const __restrict dt_len,  // n associated data lengths
+    const uint8_t* const __restrict text,   // plain texts, back to back
+    const size_t t_len,                     // len(text) = len(cipher) | >= 0
+    const size_t* const __restrict ct_off,  // n offsets into text ( & cipher )
+    const size_t* const __restrict ct_len,  // n plain text lengths
+    uint8_t* const __restrict cipher,       // cipher texts, laid out as text
+    uint8_t* const __restrict tags,         // n * 16 -bytes tags
+    const size_t n,                         // # -of messages
+    const size_t n_threads                  // # -of worker threads
+  )
+  {
+    if (!in_bounds(dt_off, dt_len, n, d_len) ||
+        !in_bounds(ct_off, ct_len, n, t_len)) {
+      return false;
+    }
+
+    std::vector<xoodyak::aead_desc_t> descs(n);
+
+    for (size_t i = 0; i < n; i++) {
+      descs[i] = { keys + i * 16,      nonces + i * 16,
+                   data + dt_off[i],   dt_len[i],
+                   text + ct_off[i],   cipher + ct_off[i],
+                   ct_len[i],          tags + i * 16 };
+    }
+
+    xoodyak_utils::parallel_for(
+      n, BATCH_GROUP, n_threads, [&](const size_t from, const size_t to) {
+        xoodyak::encrypt_batch(descs.data() + from, to - from);
+      });
+
+    return true;
+  }
+
+  // Given n messages, each with its own 16 -bytes key, nonce & tag ( back to
+  // back in `keys`/ `nonces`/ `tags` ) and associated data & cipher text, as (
+  // offset, length ) pairs into two contiguous buffers, this function decrypts
+  // all of them, same as `encrypt_batch(...)` encrypts them, writing
+  // verification status of i -th message to `flags[i]`. Returns truth value
+  // only when all of them pass verification.
+  //
+  // Plain text of i -th message is written to `text`, at same offset, as its
+  // cipher text is found at, in `cipher`; it's zeroed, if verification fails.
+  // If any associated data ( or cipher text ) doesn't lie within `data` ( or
+  // `cipher` ), nothing is decrypted, all flags are unset & false is returned.
+  bool decrypt_batch(
+    const uint8_t* const __restrict keys,   // n * 16 -bytes secret keys
+    const uint8_t* const __restrict nonces, // n * 16 -bytes nonces
+    const uint8_t* const __restrict tags,   // n * 16 -bytes tags
+    const uint8_t* const __restrict data,   // associated data, back to back
+    const size_t d_len,                     // len(data) | >= 0
+    const size_t* const __restrict dt_off,  // n offsets into data
+    const size_t* const __restrict dt_len,  // n associated data lengths
+    const uint8_t* const __restrict cipher, // cipher texts, back to back
+    const size_t c_len,                     // len(cipher) = len(text) | >= 0
+    const size_t* const __restrict ct_off,  // n offsets into cipher ( & text )
+    const size_t* const __restrict ct_len,  // n cipher text lengths
+    uint8_t* const __restrict text,         // plain texts, laid out as cipher
+    bool* const __restrict flags,           // n verification flags
+    const size_t n,                         // # -of messages
+    const size_t n_threads                  // # -of worker threads
+  )
+  {
+    if (!in_bounds(dt_off, dt_len, n, d_len) ||
+        !in_bounds(ct_off, ct_len, n, c_len)) {
+      std::fill_n(flags, n, false);
+      return false;
+    }
+
+    std::vector<xoodyak::aead_desc_t> descs(n);
+
+    for (size_t i = 0; i < n; i++) {
+      // `decrypt_batch(...)` only reads expected tag
+      uint8_t* const tag = const_cast<uint8_t*>(tags + i * 16);
+
+      descs[i] = { keys + i * 16,      nonces + i * 16,
+                   data + dt_off[i],   dt_len[i],
+                   cipher + ct_off[i], text + ct_off[i],
+                   ct_len[i],          tag };
+    }
+
+    xoodyak_utils::parallel_for(
+      n, BATCH_GROUP, n_threads, [&](const size_t from, const size_t to) {
+        xoodyak::decrypt_batch(descs.data() + from, to - from, flags + from);
+      });
+
+    return std::all_of(flags, flags + n, [](const bool f) { return f; });
+  }
 }